@@ -2348,6 +2348,14 @@ SOURCE=.\src\wpc\desound.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\wpc\dmdrec.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\wpc\dmdrec.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\wpc\driver.c
 # End Source File
 # Begin Source File
@@ -5,6 +5,7 @@
 #include "harddisk.h"
 
 static tAuditRecord *gAudits = NULL;
+static int gAuditCount = 0;
 
 static const struct GameDriver *hard_disk_gamedrv;
 
@@ -168,6 +169,7 @@ int AuditRomSet (int game, tAuditRecord **audit)
 	else
 		return 0;
 
+	gAuditCount = 0;
 	gamedrv = drivers[game];
 
 	if (!gamedrv->rom) return -1;
@@ -304,6 +306,8 @@ int AuditRomSet (int game, tAuditRecord **audit)
 			}
 		}
 
+	gAuditCount = count;
+
         #ifdef MESS
         if (!count)
                 return -1;
@@ -460,6 +464,34 @@ int VerifyRomSet (int game, verify_printf_proc verify_printf)
 }
 
 
+/* Writes one tab separated line for the set last checked by VerifyRomSet:
+   name, parent, result, number of ROMs, number of bad or missing ROMs and
+   the time the check took in milliseconds. A negative game writes the header. */
+void AuditReportSet(FILE *report, int game, int status, double seconds)
+{
+	static const char *const results[] =
+		{ "correct", "notfound", "incorrect", "clone_notfound", "best_available", "missing_optional" };
+	const struct GameDriver *gamedrv;
+	int i, bad = 0;
+
+	if (game < 0)
+	{
+		fprintf(report, "set\tparent\tresult\troms\tbad\tms\n");
+		return;
+	}
+
+	gamedrv = drivers[game];
+	for (i = 0; i < gAuditCount; i++)
+		if (gAudits[i].status & (AUD_ROM_NOT_FOUND|AUD_BAD_CHECKSUM|AUD_MEM_ERROR|AUD_LENGTH_MISMATCH|AUD_DISK_NOT_FOUND|AUD_DISK_BAD_MD5))
+			bad++;
+
+	fprintf(report, "%s\t%s\t%s\t%d\t%d\t%.3f\n", gamedrv->name,
+		(gamedrv->clone_of && !(gamedrv->clone_of->flags & NOT_A_DRIVER)) ? gamedrv->clone_of->name : "",
+		(status >= 0 && status < (int)(sizeof(results) / sizeof(results[0]))) ? results[status] : "unknown",
+		gAuditCount, bad, seconds * 1000.0);
+}
+
+
 static tMissingSample *gMissingSamples = NULL;
 
 /* Builds a list of every missing sample. Returns total number of missing
@@ -54,6 +54,7 @@ int AuditSampleSet (int game, tMissingSample **audit);
 int VerifySampleSet(int game,verify_printf_proc verify_printf);
 int RomInSet (const struct GameDriver *gamedrv, const char* hash);
 int RomsetMissing (int game);
+void AuditReportSet(FILE *report, int game, int status, double seconds);
 
 
 #endif
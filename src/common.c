@@ -12,6 +12,7 @@
 #include "artwork.h"
 #include <stdarg.h>
 #include <ctype.h>
+#include "zlib.h"
 
 
 //#define LOG_LOAD
@@ -1171,6 +1172,7 @@ static void verify_length_and_hash(struct rom_load_data *romdata, const char *na
 	/* get the length and CRC from the file */
 	actlength = (UINT32)mame_fsize(romdata->file);
 	acthash = mame_fhash(romdata->file);
+	rom_load_hash = crc32(rom_load_hash, (const Bytef *)acthash, (uInt)strlen(acthash));
 
 	/* verify length */
 	if (explength != actlength)
@@ -1811,6 +1813,9 @@ fatalerror:
 	loading system
 -------------------------------------------------*/
 
+/* CRC32 over the hashes of all the files actually loaded by rom_load */
+UINT32 rom_load_hash;
+
 int rom_load(const struct RomModule *romp)
 {
 	const struct RomModule *regionlist[REGION_MAX];
@@ -1825,6 +1830,7 @@ int rom_load(const struct RomModule *romp)
 	/* reset the romdata struct */
 	memset(&romdata, 0, sizeof(romdata));
 	romdata.romstotal = count_roms(romp);
+	rom_load_hash = 0;
 
 	/* reset the disk list */
 	memset(hard_disk_handle, 0, sizeof(hard_disk_handle));
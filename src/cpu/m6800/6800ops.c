@@ -235,6 +235,7 @@ INLINE void bra( void )
 {
 	UINT8 t;
 	IMMBYTE(t);PC+=SIGNED(t);CHANGE_PC();
+	if (m6800_idle_cpus && (t & 0x80)) m6800_idle_check();
 	/* speed up busy loops */
 	if (t==0xfe) EAT_CYCLES;
 }
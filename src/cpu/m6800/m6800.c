@@ -86,6 +86,7 @@ TODO:
 #include <stdlib.h>
 #include <string.h>
 #include "cpuintrf.h"
+#include "cpuexec.h"
 #include "state.h"
 #include "mamedbg.h"
 #include "m6800.h"
@@ -154,6 +155,11 @@ typedef struct
 /* 680x registers */
 static m6800_Regs m6800;
 
+/* idle loop skipping, see m6800_idle_check() */
+static UINT32 m6800_idle_cpus;		/* bit n set = enabled for CPU n */
+static int m6800_idle_armed = -1;	/* cpunum << 16 | address of the loop branch taken last, -1 = none */
+static UINT32 m6800_idle_busy[64];	/* branches known not to close an idle loop, (cpunum << 16 | address) + 1 */
+
 #define m6801   m6800
 #define m6802   m6800
 #define m6803	m6800
@@ -421,7 +427,7 @@ static const UINT8 flags8d[256]= /* decrement */
 
 /* Macros for branch instructions */
 #define CHANGE_PC() change_pc16(PCD)
-#define BRANCH(f) {IMMBYTE(t);if(f){PC+=SIGNED(t);CHANGE_PC();}}
+#define BRANCH(f) {IMMBYTE(t);if(f){PC+=SIGNED(t);CHANGE_PC();if(m6800_idle_cpus&&(t&0x80))m6800_idle_check();}else if(m6800_idle_cpus&&(t&0x80))m6800_idle_armed=-1;}
 #define NXORV  ((CC&0x08)^((CC&0x02)<<2))
 #define NXORC  ((CC&0x08)^((CC&0x01)<<3))
 
@@ -533,6 +539,7 @@ INLINE void WM16( UINT32 Addr, PAIR *p )
 static void ENTER_INTERRUPT(const char *message,UINT16 irq_vector)
 {
 	LOG((message, cpu_getactivecpu()));
+	m6800_idle_armed = -1;
 	if( m6800.wai_state & (M6800_WAI|M6800_SLP) )
 	{
 		if( m6800.wai_state & M6800_WAI )
@@ -589,6 +596,91 @@ static void check_timer_event(void)
 	SET_TIMER_EVENT;
 }
 
+/****************************************************************************
+ * Idle loop skipping, the same as for the 6809 (see m6809.c): a backward
+ * branch closing straight code that only loads, tests, compares and ANDs
+ * RAM is taken twice without an interrupt in between, so the CPU can sleep
+ * until the next interrupt. Only for the 6800/6802/6808, the on-chip timer
+ * interrupts of the 6801/6803/63701 don't wake up a suspended CPU and the
+ * NSC8105 has a different opcode map.
+ ****************************************************************************/
+
+#define IDLE_MAXBODY	16	/* longest loop body checked, in bytes */
+
+void m6800_set_idle_skip(int cpunum, int enable)
+{
+	if (enable)
+		m6800_idle_cpus |= 1 << cpunum;
+	else
+		m6800_idle_cpus &= ~(1 << cpunum);
+}
+
+static int m6800_idle_body(UINT32 pc, UINT32 end)
+{
+	while (pc < end)
+	{
+		UINT32 address;
+		int size = 1;
+
+		switch (M_RDOP(pc))
+		{
+		case 0x01: /* NOP */
+		case 0x4d: case 0x5d: /* TSTA TSTB */
+			pc += 1;
+			continue;
+		case 0x81: case 0x84: case 0x85: case 0xc1: case 0xc4: case 0xc5: /* CMP/AND/BIT A/B # */
+			pc += 2;
+			continue;
+		case 0x8c: /* CPX # */
+			pc += 3;
+			continue;
+		case 0x9c: case 0x9e: case 0xde: /* CPX LDS LDX direct */
+			size = 2;
+			/* fall through */
+		case 0x91: case 0x94: case 0x95: case 0x96: case 0xd1: case 0xd4: case 0xd5: case 0xd6: /* CMP/AND/BIT/LDA A/B direct */
+			address = M_RDOP_ARG(pc + 1);
+			pc += 2;
+			break;
+		case 0xbc: case 0xbe: case 0xfe: /* CPX LDS LDX extended */
+			size = 2;
+			/* fall through */
+		case 0x7d: case 0xb1: case 0xb4: case 0xb5: case 0xb6: case 0xf1: case 0xf4: case 0xf5: case 0xf6: /* TST CMP/AND/BIT/LDA A/B extended */
+			address = (M_RDOP_ARG(pc + 1) << 8) | M_RDOP_ARG(pc + 2);
+			pc += 3;
+			break;
+		default:
+			return 0;
+		}
+		if (!memory_is_direct_read(address) || (size == 2 && !memory_is_direct_read((address + 1) & 0xffff)))
+			return 0;
+	}
+	return pc == end;
+}
+
+static void m6800_idle_check(void)
+{
+	const int cpunum = cpu_getactivecpu();
+	const UINT16 ppc = m6800.ppc.w.l;
+	const int key = (cpunum << 16) | ppc;
+	UINT32 *busy = &m6800_idle_busy[(ppc ^ (ppc >> 6)) & 63];
+
+	if (!(m6800_idle_cpus & (1 << cpunum)) || *busy == (UINT32)key + 1)
+		return;
+	if (PC > ppc || ppc - PC > IDLE_MAXBODY || !m6800_idle_body(PC, ppc))
+	{
+		/* banked code may change, but that only costs a missed idle loop */
+		*busy = key + 1;
+		return;
+	}
+	if (m6800_idle_armed != key)
+	{
+		m6800_idle_armed = key;
+		return;
+	}
+	m6800_idle_armed = -1;
+	cpu_spinuntil_int();
+}
+
 /* include the opcode prototypes and function pointer tables */
 #include "6800tbl.c"
 
@@ -642,6 +734,9 @@ void m6800_reset(void *param)
 	OCD = 0xffff;
 	TOD = 0xffff;
 	m6800.ram_ctrl |= 0x40;
+
+	m6800_idle_armed = -1;
+	memset(m6800_idle_busy, 0, sizeof(m6800_idle_busy));
 }
 
 /****************************************************************************
@@ -40,6 +40,7 @@ void m6800_set_irq_line(int irqline, int state);
 void m6800_set_irq_callback(int (*callback)(int irqline));
 const char *m6800_info(void *context, int regnum);
 unsigned m6800_dasm(char *buffer, unsigned pc);
+void m6800_set_idle_skip(int cpunum, int enable);
 
 /****************************************************************************
  * For now make the 6801 using the m6800 variables and functions
@@ -375,6 +375,8 @@ INLINE void bra( void )
 	IMMBYTE(t);
 	PC += SIGNED(t);
     CHANGE_PC;
+	if( m6809_idle_cpus && (t & 0x80) )
+		m6809_idle_check();
 	/* JB 970823 - speed up busy loops */
 	if( t == 0xfe )
 		if( m6809_ICount > 0 ) m6809_ICount = 0;
@@ -73,6 +73,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "cpuintrf.h"
+#include "cpuexec.h"
 #include "state.h"
 #include "mamedbg.h"
 #include "m6809.h"
@@ -139,6 +140,11 @@ typedef struct
 static m6809_Regs m6809;
 int m6809_slapstic = 0;
 
+/* idle loop skipping, see m6809_idle_check() */
+static UINT32 m6809_idle_cpus;		/* bit n set = enabled for CPU n */
+static int m6809_idle_armed = -1;	/* cpunum << 16 | address of the loop branch taken last, -1 = none */
+static UINT32 m6809_idle_busy[64];	/* branches known not to close an idle loop, (cpunum << 16 | address) + 1 */
+
 #define pPPC    m6809.ppc
 #define pPC 	m6809.pc
 #define pU		m6809.u
@@ -204,6 +210,7 @@ static PAIR ea;         /* effective address */
 			m6809.extra_cycles += 10;	/* subtract +10 cycles */		\
 		}																\
 		CC |= CC_IF | CC_II;			/* inhibit FIRQ and IRQ */		\
+		m6809_idle_armed = -1;											\
 		PCD=RM16(0xfff6);												\
 		CHANGE_PC;														\
 		(void)(*m6809.irq_callback)(M6809_FIRQ_LINE);					\
@@ -232,6 +239,7 @@ static PAIR ea;         /* effective address */
 			m6809.extra_cycles += 19;	 /* subtract +19 cycles */		\
 		}																\
 		CC |= CC_II;					/* inhibit IRQ */				\
+		m6809_idle_armed = -1;											\
 		PCD=RM16(0xfff8);												\
 		CHANGE_PC;														\
 		(void)(*m6809.irq_callback)(M6809_IRQ_LINE);					\
@@ -363,7 +371,11 @@ CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N,CC_N
 	{									\
 		PC += SIGNED(t);				\
 		CHANGE_PC;						\
+		if( m6809_idle_cpus && (t & 0x80) ) \
+			m6809_idle_check(); 		\
 	}									\
+	else if( m6809_idle_cpus && (t & 0x80) ) \
+		m6809_idle_armed = -1;	/* left the loop */ \
 }
 
 #define LBRANCH(f) {                    \
@@ -542,6 +554,9 @@ void m6809_reset(void *param)
 
 	PCD = RM16(0xfffe);
 	CHANGE_PC;
+
+	m6809_idle_armed = -1;
+	memset(m6809_idle_busy, 0, sizeof(m6809_idle_busy));
 }
 
 void m6809_exit(void)
@@ -586,6 +601,7 @@ void m6809_set_irq_line(int irqline, int state)
 			m6809.extra_cycles += 19;	/* subtract +19 cycles next time */
 		}
 		CC |= CC_IF | CC_II;			/* inhibit FIRQ and IRQ */
+		m6809_idle_armed = -1;
 		PCD = RM16(0xfffc);
 		CHANGE_PC;
 	}
@@ -667,6 +683,96 @@ unsigned m6809_dasm(char *buffer, unsigned pc)
 #endif
 }
 
+/****************************************************************************
+ * Idle loop skipping
+ *
+ * Enabled per CPU by the driver. When a backward branch is taken, the loop
+ * body it closes is checked: if it is straight code that only reads RAM
+ * (or ROM/banks without handlers, see memory_is_direct_read()) with loads,
+ * tests, compares and ANDs, every pass leaves the registers the same as the
+ * one before, so once it ran through without an interrupt in between it
+ * keeps looping until an interrupt changes the RAM. The body can only be
+ * left through its branch not being taken or an interrupt, both disarm it. The CPU is then
+ * suspended until the next interrupt, eating the cycles in between.
+ * RAM written by another CPU or by a driver timer is not noticed, which is
+ * why drivers have to opt in.
+ ****************************************************************************/
+
+#define IDLE_MAXBODY	16	/* longest loop body checked, in bytes */
+
+void m6809_set_idle_skip(int cpunum, int enable)
+{
+	if (enable)
+		m6809_idle_cpus |= 1 << cpunum;
+	else
+		m6809_idle_cpus &= ~(1 << cpunum);
+}
+
+static int m6809_idle_body(UINT32 pc, UINT32 end)
+{
+	while (pc < end)
+	{
+		UINT32 address;
+		int size = 1;
+
+		switch (ROP(pc))
+		{
+		case 0x12: /* NOP */
+		case 0x4d: case 0x5d: /* TSTA TSTB */
+			pc += 1;
+			continue;
+		case 0x81: case 0x84: case 0x85: case 0xc1: case 0xc4: case 0xc5: /* CMP/AND/BIT A/B # */
+			pc += 2;
+			continue;
+		case 0x8c: /* CMPX # */
+			pc += 3;
+			continue;
+		case 0x9c: case 0x9e: case 0xdc: case 0xde: /* CMPX LDX LDD LDU < */
+			size = 2;
+			/* fall through */
+		case 0x0d: case 0x91: case 0x94: case 0x95: case 0x96: case 0xd1: case 0xd4: case 0xd5: case 0xd6: /* TST CMP/AND/BIT/LD A/B < */
+			address = (DP << 8) | ROP_ARG(pc + 1);
+			pc += 2;
+			break;
+		case 0xbc: case 0xbe: case 0xfc: case 0xfe: /* CMPX LDX LDD LDU > */
+			size = 2;
+			/* fall through */
+		case 0x7d: case 0xb1: case 0xb4: case 0xb5: case 0xb6: case 0xf1: case 0xf4: case 0xf5: case 0xf6: /* TST CMP/AND/BIT/LD A/B > */
+			address = (ROP_ARG(pc + 1) << 8) | ROP_ARG(pc + 2);
+			pc += 3;
+			break;
+		default:
+			return 0;
+		}
+		if (!memory_is_direct_read(address) || (size == 2 && !memory_is_direct_read((address + 1) & 0xffff)))
+			return 0;
+	}
+	return pc == end;
+}
+
+static void m6809_idle_check(void)
+{
+	const int cpunum = cpu_getactivecpu();
+	const int key = (cpunum << 16) | PPC;
+	UINT32 *busy = &m6809_idle_busy[(PPC ^ (PPC >> 6)) & 63];
+
+	if (!(m6809_idle_cpus & (1 << cpunum)) || *busy == (UINT32)key + 1)
+		return;
+	if (PC > PPC || PPC - PC > IDLE_MAXBODY || !m6809_idle_body(PC, PPC))
+	{
+		/* banked code may change, but that only costs a missed idle loop */
+		*busy = key + 1;
+		return;
+	}
+	if (m6809_idle_armed != key)
+	{
+		m6809_idle_armed = key;
+		return;
+	}
+	m6809_idle_armed = -1;
+	cpu_spinuntil_int();
+}
+
 /* includes the static function prototypes and the master opcode table */
 #include "6809tbl.c"
 
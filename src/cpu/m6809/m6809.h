@@ -33,6 +33,7 @@ extern void m6809_set_irq_line(int irqline, int state);
 extern void m6809_set_irq_callback(int (*callback)(int irqline));
 extern const char *m6809_info(void *context,int regnum);
 extern unsigned m6809_dasm(char *buffer, unsigned pc);
+extern void m6809_set_idle_skip(int cpunum, int enable);
 
 /****************************************************************************/
 /* Read a byte from given memory location                                   */
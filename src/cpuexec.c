@@ -11,9 +11,14 @@
 #include "timer.h"
 #include "state.h"
 #include "video.h"
+#include "zlib.h"
 #include "mamedbg.h"
 #include "hiscore.h"
 
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+ #include <intrin.h>
+#endif
+
 #if (HAS_M68000 || HAS_M68010 || HAS_M68020 || HAS_M68EC020)
 #include "cpu/m68000/m68000.h"
 #endif
@@ -213,6 +218,43 @@ static double perfect_interleave;
 static int loadsave_schedule;
 static char *loadsave_schedule_name;
 
+/* requested by the frontend (possibly from another thread): the frontend fills in the
+   fields below and then publishes snapshot_request, the emulation thread publishes
+   SNAPSHOT_NONE once it's done with them (and the export is ready) */
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+ #define SNAPSHOT_LOAD_ACQUIRE(p)      ((int)_InterlockedCompareExchange((volatile long*)(p), 0, 0))
+ #define SNAPSHOT_STORE_RELEASE(p, v)  _InterlockedExchange((volatile long*)(p), (long)(v))
+#elif defined(__GNUC__)
+ #define SNAPSHOT_LOAD_ACQUIRE(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+ #define SNAPSHOT_STORE_RELEASE(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else // older compilers on x86 only, where the stores aren't reordered
+ #define SNAPSHOT_LOAD_ACQUIRE(p)      (*(p))
+ #define SNAPSHOT_STORE_RELEASE(p, v)  (*(p) = (v))
+#endif
+static volatile int snapshot_request;
+static int snapshot_request_age;
+static UINT8 *snapshot_request_image;
+static size_t snapshot_request_size;
+static UINT8 *snapshot_export_image;
+static size_t snapshot_export_size;
+
+/* periodic snapshots, emulation thread only */
+static void *snapshot_timer;
+static int snapshot_due;
+
+/* boot snapshot cache: the state some seconds after power on, keyed by the ROMs, NVRAM and version */
+enum
+{
+	BOOTSNAP_OFF,
+	BOOTSNAP_SAVE,		/* no matching cache file, write one once booted */
+	BOOTSNAP_DONE
+};
+#define BOOTSNAP_MAGIC		"PMBOOT1"
+#define BOOTSNAP_KEYSIZE	48
+static int boot_snapshot_state;
+static int boot_snapshot_due;
+static UINT8 boot_snapshot_key[BOOTSNAP_KEYSIZE];
+
 
 
 /*************************************
@@ -230,6 +272,11 @@ static void end_interleave_boost(int param);
 static void compute_perfect_interleave(void);
 
 static void handle_loadsave(void);
+static void handle_snapshot(void);
+static void snapshot_callback(int param);
+static void boot_snapshot_init(void);
+static void handle_boot_snapshot(void);
+static void boot_snapshot_callback(int param);
 
 #ifdef PINMAME
 void run_one_timeslice(void) {
@@ -395,6 +442,10 @@ void cpu_run(void)
 		mame_debug_init();
 #endif
 
+	/* restore the machine state after power on from the cache, if there's a valid one */
+	boot_snapshot_init();
+	perfcount_init();
+
 	/* loop over multiple resets, until the user quits */
 	time_to_quit = 0;
 	while (!time_to_quit)
@@ -411,6 +462,10 @@ void cpu_run(void)
 			/* if we have a load/save scheduled, handle it */
 			if (loadsave_schedule != LOADSAVE_NONE)
 				handle_loadsave();
+			if (SNAPSHOT_LOAD_ACQUIRE(&snapshot_request) != SNAPSHOT_NONE || snapshot_due)
+				handle_snapshot();
+			if (boot_snapshot_due)
+				handle_boot_snapshot();
 			
 			/* execute CPUs */
 			cpu_timeslice();
@@ -421,6 +476,7 @@ void cpu_run(void)
 		/* finish up this iteration */
 		cpu_post_run();
 	}
+	perfcount_exit();
 
 #ifdef MAME_DEBUG
 	/* shut down the debugger */
@@ -444,6 +500,14 @@ void cpu_exit(void)
 	/* shut down the CPU cores */
 	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
 		cpuintrf_exit_cpu(cpunum);
+
+	/* drop the snapshots */
+	state_snapshot_exit();
+	free(snapshot_request_image);
+	snapshot_request_image = NULL;
+	free(snapshot_export_image);
+	snapshot_export_image = NULL;
+	SNAPSHOT_STORE_RELEASE(&snapshot_request, SNAPSHOT_NONE);
 }
 
 
@@ -468,6 +532,64 @@ void machine_reset(void)
 #pragma mark SAVE/RESTORE
 #endif
 
+/*************************************
+ *
+ *	Save/load the state of the
+ *	whole machine
+ *
+ *************************************/
+
+static void save_all_tags(void)
+{
+	int cpunum;
+
+	/* write tag 0 */
+	state_save_set_current_tag(0);
+	state_save_save_continue();
+
+	/* loop over CPUs */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+	{
+		cpuintrf_push_context(cpunum);
+
+		/* make sure banking is set */
+		activecpu_reset_banking();
+
+		/* save the CPU data */
+		state_save_set_current_tag(cpunum + 1);
+		state_save_save_continue();
+
+		cpuintrf_pop_context();
+	}
+}
+
+
+static void load_all_tags(void)
+{
+	int cpunum;
+
+	/* read tag 0 */
+	state_save_set_current_tag(0);
+	state_save_load_continue();
+
+	/* loop over CPUs */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+	{
+		cpuintrf_push_context(cpunum);
+
+		/* make sure banking is set */
+		activecpu_reset_banking();
+
+		/* load the CPU data */
+		state_save_set_current_tag(cpunum + 1);
+		state_save_load_continue();
+
+		cpuintrf_pop_context();
+	}
+}
+
+
+
 /*************************************
  *
  *	Handle saves at runtime
@@ -483,29 +605,9 @@ static void handle_save(void)
 
 	if (file)
 	{
-		int cpunum;
-
 		/* write the save state */
 		state_save_save_begin(file);
-
-		/* write tag 0 */
-		state_save_set_current_tag(0);
-		state_save_save_continue();
-
-		/* loop over CPUs */
-		for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
-		{
-			cpuintrf_push_context(cpunum);
-
-			/* make sure banking is set */
-			activecpu_reset_banking();
-
-			/* save the CPU data */
-			state_save_set_current_tag(cpunum + 1);
-			state_save_save_continue();
-
-			cpuintrf_pop_context();
-		}
+		save_all_tags();
 
 		/* finish and close */
 		state_save_save_finish();
@@ -541,26 +643,7 @@ static void handle_load(void)
 		/* start loading */
 		if (!state_save_load_begin(file))
 		{
-			int cpunum;
-
-			/* read tag 0 */
-			state_save_set_current_tag(0);
-			state_save_load_continue();
-
-			/* loop over CPUs */
-			for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
-			{
-				cpuintrf_push_context(cpunum);
-
-				/* make sure banking is set */
-				activecpu_reset_banking();
-
-				/* load the CPU data */
-				state_save_set_current_tag(cpunum + 1);
-				state_save_load_continue();
-
-				cpuintrf_pop_context();
-			}
+			load_all_tags();
 
 			/* finish and close */
 			state_save_load_finish();
@@ -650,6 +733,228 @@ void cpu_loadsave_reset(void)
 }
 
 
+
+/*************************************
+ *
+ *	Handle in-memory snapshots
+ *
+ *************************************/
+
+static void load_image(const UINT8 *image, size_t size)
+{
+	if (!state_save_load_begin_mem(image, size))
+	{
+		load_all_tags();
+		state_save_load_finish();
+	}
+}
+
+
+static void handle_snapshot(void)
+{
+	/* the request fields are only valid after this read */
+	const int request = (int)SNAPSHOT_LOAD_ACQUIRE(&snapshot_request);
+	UINT8 *image;
+	size_t size;
+	double time;
+
+	/* requests first, a periodic snapshot taken before would change the age to restore */
+	switch (request)
+	{
+		case SNAPSHOT_RESTORE:
+			image = state_snapshot_get(snapshot_request_age, &size, &time);
+			if (image)
+			{
+				load_image(image, size);
+				free(image);
+				state_snapshot_discard(snapshot_request_age);
+			}
+			break;
+
+		case SNAPSHOT_LOAD:
+			load_image(snapshot_request_image, snapshot_request_size);
+			free(snapshot_request_image);
+			snapshot_request_image = NULL;
+			break;
+
+		case SNAPSHOT_EXPORT:
+			snapshot_export_image = state_snapshot_get(snapshot_request_age, &snapshot_export_size, &time);
+			break;
+	}
+
+	/* periodic snapshot, or requested by the frontend */
+	if (snapshot_due || request == SNAPSHOT_TAKE)
+	{
+		state_save_save_begin_mem();
+		save_all_tags();
+		image = state_save_save_finish_mem(&size);
+		if (image)
+			state_snapshot_add(image, size, timer_get_time());
+		snapshot_due = 0;
+	}
+
+	/* last, as the frontend may be waiting for it */
+	if (request != SNAPSHOT_NONE)
+		SNAPSHOT_STORE_RELEASE(&snapshot_request, SNAPSHOT_NONE);
+}
+
+
+static void snapshot_callback(int param)
+{
+	snapshot_due = 1;
+}
+
+
+
+/*************************************
+ *
+ *	Request an in-memory snapshot
+ *	operation, returns 1 if another
+ *	one is still pending, the game
+ *	doesn't support snapshots or
+ *	there's no snapshot of that age
+ *
+ *************************************/
+
+int cpu_snapshot_schedule(int type, int age, UINT8 *image, size_t size)
+{
+	if (!(Machine->gamedrv->flags & GAME_SUPPORTS_SAVE))
+		return 1;
+	if ((type == SNAPSHOT_RESTORE || type == SNAPSHOT_EXPORT) && (age < 0 || age >= state_snapshot_count()))
+		return 1;
+	if (SNAPSHOT_LOAD_ACQUIRE(&snapshot_request) != SNAPSHOT_NONE)
+		return 1;
+
+	/* the previous export is dropped by the next request */
+	free(snapshot_export_image);
+	snapshot_export_image = NULL;
+	snapshot_export_size = 0;
+
+	snapshot_request_age = age;
+	snapshot_request_image = image;
+	snapshot_request_size = size;
+	SNAPSHOT_STORE_RELEASE(&snapshot_request, type);
+	return 0;
+}
+
+
+int cpu_snapshot_pending(void)
+{
+	return SNAPSHOT_LOAD_ACQUIRE(&snapshot_request) != SNAPSHOT_NONE;
+}
+
+
+UINT8 *cpu_snapshot_exported(size_t *size)
+{
+	*size = snapshot_export_size;
+	return snapshot_export_image;
+}
+
+
+
+/*************************************
+ *
+ *	Boot snapshot cache
+ *
+ *************************************/
+
+static void boot_snapshot_init(void)
+{
+	mame_file *file;
+	UINT8 key[BOOTSNAP_KEYSIZE];
+	UINT32 nvram_hash = 0;
+	char name[256];
+
+	boot_snapshot_state = BOOTSNAP_OFF;
+	if (options.boot_snapshot_time <= 0.)
+		return;
+
+	/* restoring onto freshly reset hardware needs the driver and peripheral state too */
+	if (!(Machine->gamedrv->flags & GAME_SUPPORTS_SAVE))
+		return;
+
+	/* the NVRAM as it was loaded at startup */
+	file = mame_fopen(Machine->gamedrv->name, 0, FILETYPE_NVRAM, 0);
+	if (file)
+	{
+		UINT32 size = (UINT32)mame_fsize(file);
+		UINT8 *data = malloc(size);
+		if (data)
+		{
+			mame_fread(file, data, size);
+			nvram_hash = crc32(0, data, size);
+			free(data);
+		}
+		mame_fclose(file);
+	}
+
+	/* build the key */
+	memset(boot_snapshot_key, 0, sizeof(boot_snapshot_key));
+	memcpy(boot_snapshot_key, BOOTSNAP_MAGIC, sizeof(BOOTSNAP_MAGIC));
+	memcpy(boot_snapshot_key + 8, &rom_load_hash, 4);
+	memcpy(boot_snapshot_key + 12, &nvram_hash, 4);
+	strncpy((char *)boot_snapshot_key + 16, build_version, BOOTSNAP_KEYSIZE - 16 - 1);
+
+	/* look for a matching cache file */
+	boot_snapshot_state = BOOTSNAP_SAVE;
+	sprintf(name, "%s-boot", Machine->gamedrv->name);
+	file = mame_fopen(Machine->gamedrv->name, name, FILETYPE_STATE, 0);
+	if (file)
+	{
+		const UINT32 size = (UINT32)mame_fsize(file);
+		if (size > BOOTSNAP_KEYSIZE && mame_fread(file, key, BOOTSNAP_KEYSIZE) == BOOTSNAP_KEYSIZE &&
+			memcmp(key, boot_snapshot_key, BOOTSNAP_KEYSIZE) == 0)
+		{
+			UINT8 *image = malloc(size - BOOTSNAP_KEYSIZE);
+			if (image && mame_fread(file, image, size - BOOTSNAP_KEYSIZE) == size - BOOTSNAP_KEYSIZE &&
+				!cpu_snapshot_schedule(SNAPSHOT_LOAD, 0, image, size - BOOTSNAP_KEYSIZE))
+			{
+				logerror("Restoring the boot snapshot %s\n", name);
+				boot_snapshot_state = BOOTSNAP_DONE;
+			}
+			else
+				free(image);
+		}
+		mame_fclose(file);
+	}
+}
+
+
+static void handle_boot_snapshot(void)
+{
+	mame_file *file;
+	UINT8 *image;
+	size_t size;
+	char name[256];
+
+	boot_snapshot_due = 0;
+	boot_snapshot_state = BOOTSNAP_DONE;
+
+	state_save_save_begin_mem();
+	save_all_tags();
+	image = state_save_save_finish_mem(&size);
+	if (!image)
+		return;
+
+	sprintf(name, "%s-boot", Machine->gamedrv->name);
+	file = mame_fopen(Machine->gamedrv->name, name, FILETYPE_STATE, 1);
+	if (file)
+	{
+		mame_fwrite(file, boot_snapshot_key, BOOTSNAP_KEYSIZE);
+		mame_fwrite(file, image, size);
+		mame_fclose(file);
+		logerror("Saved the boot snapshot %s\n", name);
+	}
+	free(image);
+}
+
+
+static void boot_snapshot_callback(int param)
+{
+	boot_snapshot_due = 1;
+}
+
+
 #if 0
 #pragma mark -
 #pragma mark WATCHDOG
@@ -834,11 +1139,14 @@ static void cpu_timeslice(void)
 			/* run for the requested number of cycles */
 			if (cycles_running > 0)
 			{
+				cycles_t start = perfcount_active ? osd_cycles() : 0;
 				profiler_mark(PROFILER_CPU1 + cpunum);
 				cycles_stolen = 0;
 				ran = cpunum_execute(cpunum, cycles_running);
 				ran -= cycles_stolen;
 				profiler_mark(PROFILER_END);
+				if (perfcount_active)
+					perfcount_add(PERFCOUNT_CPU, cpunum, NULL, ran, start);
 				
 				/* account for these cycles */
 				cpu[cpunum].totalcycles += ran;
@@ -867,6 +1175,8 @@ static void cpu_timeslice(void)
 
 			cpu[cpunum].totalcycles += cycles_running;
 			cpu[cpunum].localtime += TIME_IN_CYCLES(cycles_running, cpunum);
+			if (perfcount_active)
+				perfcount_add(PERFCOUNT_SKIPPED, cpunum, NULL, cycles_running, osd_cycles());
 			LOG(("         %d skipped, %d total, time = %.9f\n", cycles_running, (INT32)cpu[cpunum].totalcycles, cpu[cpunum].localtime));
 		}
 		
@@ -1813,6 +2123,20 @@ static void cpu_inittimers(void)
 	timeslice_timer = timer_alloc(cpu_timeslicecallback);
 	timer_adjust(timeslice_timer, timeslice_period, 0, timeslice_period);
 	
+	/* allocate the in-memory snapshot ring and a timer to fill it periodically */
+	state_snapshot_init((Machine->gamedrv->flags & GAME_SUPPORTS_SAVE) ? options.snapshot_count : 0);
+	if ((Machine->gamedrv->flags & GAME_SUPPORTS_SAVE) && options.snapshot_count > 0 && options.snapshot_interval > 0.)
+	{
+		snapshot_timer = timer_alloc(snapshot_callback);
+		timer_adjust(snapshot_timer, options.snapshot_interval, 0, options.snapshot_interval);
+	}
+	snapshot_due = 0;
+
+	/* write the boot snapshot cache once the machine has booted */
+	if (boot_snapshot_state == BOOTSNAP_SAVE)
+		timer_set(options.boot_snapshot_time, 0, boot_snapshot_callback);
+	boot_snapshot_due = 0;
+
 	/* allocate timers to handle interleave boosts */
 	interleave_boost_timer = timer_alloc(NULL);
 	interleave_boost_timer_end = timer_alloc(end_interleave_boost);
@@ -114,6 +114,21 @@ void cpu_loadsave_schedule(int type, char id);
 void cpu_loadsave_schedule_file(int type, const char *name);
 void cpu_loadsave_reset(void);
 
+/* In-memory snapshots (see state.c), handled between timeslices like load/save.
+   Only available for games flagged GAME_SUPPORTS_SAVE, as restoring the CPUs and RAM
+   alone on top of the current driver state leaves an inconsistent machine */
+enum
+{
+	SNAPSHOT_NONE,
+	SNAPSHOT_TAKE,		/* add a snapshot to the ring */
+	SNAPSHOT_RESTORE,	/* rewind to the snapshot age steps back, dropping the newer ones */
+	SNAPSHOT_LOAD,		/* load the given image */
+	SNAPSHOT_EXPORT		/* rebuild the snapshot age steps back for cpu_snapshot_exported() */
+};
+int cpu_snapshot_schedule(int type, int age, UINT8 *image, size_t size);
+int cpu_snapshot_pending(void);
+UINT8 *cpu_snapshot_exported(size_t *size);
+
 
 
 /*************************************
@@ -832,6 +832,7 @@ INLINE void set_cpu_context(int cpunum)
 {
 	int newfamily = cpu[cpunum].family;
 	int oldcontext = cpu_active_context[newfamily];
+	cycles_t start = (perfcount_active && oldcontext != cpunum) ? osd_cycles() : 0;
 
 	/* if we need to change contexts, save the one that was there */
 	if (oldcontext != cpunum && oldcontext != -1)
@@ -846,6 +847,9 @@ INLINE void set_cpu_context(int cpunum)
 	{
 		(*cpu[cpunum].intf.set_context)(cpu[cpunum].context);
 		cpu_active_context[newfamily] = cpunum;
+
+		if (perfcount_active)
+			perfcount_add(PERFCOUNT_CONTEXT, cpunum, NULL, 0, start);
 	}
 }
 
@@ -3,16 +3,37 @@
 #include <stdio.h>
 #include <conio.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 void DisplayDMD();
+bool CheckCallbacks();
+bool CheckFrames();
 unsigned char* rawDMD = nullptr;
 
+// counted from the emulation thread
+std::atomic<int> solenoidCalls(0), lampCalls(0), dmdFrameCalls(0), soundCommandCalls(0);
+
+void OnSolenoid(int solNo, int isActive, double emuTime) { solenoidCalls++; }
+void OnLamp(int lampNo, int currStat, double emuTime) { lampCalls++; }
+void OnDMDFrame(const unsigned char* frame, int width, int height, double emuTime) { dmdFrameCalls++; }
+void OnSoundCommand(int boardNo, int cmd, double emuTime) { soundCommandCalls++; }
+
 int main()
 {
 	SetVPMPath("C:/PinMAME/");
 	SetSampleRate(48000);
+	SetSolenoidCallback(OnSolenoid);
+	SetLampCallback(OnLamp);
+	SetDMDFrameCallback(OnDMDFrame);
+	SetSoundCommandCallback(OnSoundCommand);
 
 	StartThreadedGame("taf_l7");
+	if (!CheckCallbacks())
+		printf("callback check FAILED\n");
+	if (!CheckFrames())
+		printf("frame check FAILED\n");
 
 	//Sleep(1000);
 
@@ -57,6 +78,12 @@ int main()
 
 		if (c == 'r')
 			ResetGame();
+
+		if (c == 'c')
+			CheckCallbacks();
+
+		if (c == 'f')
+			CheckFrames();
 	}
 	
 	StopThreadedGame(true);
@@ -87,3 +114,41 @@ void DisplayDMD()
 	}
 	//printf("\n");
 }
+
+// taf_l7 boots into attract mode within a few seconds, where it flashes lamps, shows DMD frames
+// and sends sound commands (solenoids may stay off without a ball or a coin, so they're only reported)
+bool CheckCallbacks()
+{
+	for (int i = 0; i < 100 && !(lampCalls > 0 && dmdFrameCalls > 0 && soundCommandCalls > 0); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	printf("callbacks: %d solenoid, %d lamp, %d DMD frame, %d sound command\n",
+		(int)solenoidCalls, (int)lampCalls, (int)dmdFrameCalls, (int)soundCommandCalls);
+	return lampCalls > 0 && dmdFrameCalls > 0 && soundCommandCalls > 0;
+}
+
+// the DMD triple buffer has to hand out a frame, and a newer one a little later
+bool CheckFrames()
+{
+	PinmameFrame frame;
+	unsigned int first = 0;
+	for (int i = 0; i < 100; i++)
+	{
+		if (AcquireDMDFrame(&frame))
+		{
+			if (first == 0)
+			{
+				first = frame.sequence;
+				printf("DMD frame %u: %dx%d, format %d, emulated time %.3f\n", frame.sequence, frame.width, frame.height, frame.format, frame.emuTime);
+			}
+			else if (frame.sequence != first)
+			{
+				printf("DMD frame %u: %dx%d, format %d, emulated time %.3f\n", frame.sequence, frame.width, frame.height, frame.format, frame.emuTime);
+				return frame.data != nullptr && frame.width > 0 && frame.height > 0 && frame.format != PINMAME_FRAME_NONE;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	printf("no%s DMD frame acquired\n", first ? " new" : "");
+	return false;
+}
@@ -142,6 +142,7 @@ struct rc_option fileio_opts[] =
 	{ "ctrlr_directory", NULL, rc_string, &pathlist[FILETYPE_CTRLR].rawpath, "ctrlr", 0, 0, NULL, "directory to save controller definitions" },
 #ifdef PINMAME
 	{ "wave_directory", NULL, rc_string, &pathlist[FILETYPE_WAVE].rawpath, "wave", 0, 0, NULL, "directory for wave files" },
+	{ "romcache_directory", NULL, rc_string, &pathlist[FILETYPE_ROMCACHE].rawpath, "romcache", 0, 0, NULL, "directory for the unzipped ROM cache" },
 #endif /* PINMAME */
 	{ "cheat_file", NULL, rc_string, &cheatfile, "cheat.dat", 0, 0, NULL, "cheat filename" },
 	{ "history_file", NULL, rc_string, &history_filename, "history.dat", 0, 0, NULL, NULL },
@@ -551,7 +552,7 @@ osd_file *osd_fopen(int pathtype, int pathindex, const char *filename, const cha
 
 	/* find an empty file handle */
 	for (i = 0; i < MAX_OPEN_FILES; i++)
-		if (openfile[i].handle == NULL || openfile[i].handle == INVALID_HANDLE_VALUE)
+		if (openfile[i].handle == 0 || openfile[i].handle == INVALID_HANDLE_VALUE)
 			break;
 	if (i == MAX_OPEN_FILES)
 		return NULL;
@@ -825,7 +826,7 @@ void osd_fclose(osd_file *file)
 #else
 		close(file->handle);
 #endif
-	file->handle = NULL;
+	file->handle = 0;
 }
 
 
@@ -39,11 +39,14 @@ void CloseConsole()
 #define strcasecmp _stricmp
 
 #else
-#define strcpy_s strcpy
 #define MAX_PATH          1024
 #endif
 
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <algorithm>
 
 #if defined(_WIN32) || defined(_WIN64)
  #include <../win32com/Alias.h> //!! move that one to some platform independent section
@@ -70,6 +73,7 @@ extern "C"
 	extern unsigned int g_raw_dmdx;
 	extern unsigned int g_raw_dmdy;
 	extern unsigned int g_needs_DMD_update;
+	extern unsigned char g_raw_dmd_dirtyrows[DMD_MAXY];
 
 	volatile int g_fHandleKeyboard = 0;
 	volatile int g_fHandleMechanics = 0;
@@ -77,6 +81,10 @@ extern "C"
 
 	void OnSolenoid(int nSolenoid, int IsActive);
 	void OnStateChange(int nChange);
+	void OnOutputsUpdated(void);
+	void OnDMDFrame(int width, int height, int shades);
+	void OnSegmentFrame(const UINT16* segments, int count);
+	void OnSoundCommand(int boardNo, int cmd);
 #if defined(_WIN32) || defined(_WIN64)
 	extern void win_timer_enable(int enabled);
 #endif
@@ -92,20 +100,117 @@ extern "C"
 	char g_szGameName[256] = { 0 }; // String containing requested game name (may be different from ROM if aliased)
 
 	extern int channels;
+	extern int fastfrms;
 
-	struct rc_struct *rc;
+	extern struct rc_struct *rc; // minimalconfig.c
 }
 
-static char vpmPath[MAX_PATH] = { 0 };
-static int sampleRate = 48000;
+// settings for the next StartThreadedGame, see the setup functions
+struct GameSettings
+{
+	char vpmPath[MAX_PATH];
+	int sampleRate;
+	int audioLatency; // msecs
+	bool throttle;
+	int bootSnapshotTime; // msecs of emulated time, 0 = off
+	bool romCache;
+	bool dcsCache;
+	bool idleSkip;
+	bool perfCounters;
+	char perfTrace[MAX_PATH]; // empty = no trace file
+	char dmdRecord[MAX_PATH]; // empty = no DMD sub-frame recording
+	char nvramPath[MAX_PATH]; // empty = <vpmPath>nvram
+};
+
+static GameSettings settings = { { 0 }, 48000, 40, true, 0, false, false, false, false, { 0 }, { 0 }, { 0 } };
 
 static volatile bool isGameReady = false;
+static volatile bool isGameThreadRunning = false;
 
 static std::thread* pRunningGame = nullptr;
 
 static int initialSwitches[CORE_MAXSWCOL*8 * 2]; // for each switch: number and state (0 or 1)
 static int initialSwitchesToSet = 0;
 
+// output callbacks, set from the host thread and invoked from the emulation thread
+static volatile SolenoidCallback solenoidCallback = nullptr;
+static volatile LampCallback lampCallback = nullptr;
+static volatile GICallback giCallback = nullptr;
+static volatile DMDFrameCallback dmdFrameCallback = nullptr;
+static volatile SoundCommandCallback soundCommandCallback = nullptr;
+
+// scripted switch changes, sorted by emulated time, applied by scriptTimer from the emulation thread
+struct QueuedSwitch
+{
+	double time;
+	int slot;
+	bool state;
+};
+
+static std::mutex switchQueueMutex;
+static std::deque<QueuedSwitch> switchQueue;
+static volatile double stopTime = 0.;
+static mame_timer* scriptTimer = nullptr; // emulation thread only
+static double scriptTimerExpire = TIME_NEVER;
+
+static void armScriptTimer();
+
+// latest completed DMD/segment frames, handed from the emulation thread to the host without locking:
+// publish swaps the filled back slot with the middle slot, acquire swaps the front slot with the middle
+// slot if that one holds a newer frame, so the host reads its front slot while the next frames are written
+template <typename Slot>
+struct FrameTripleBuffer
+{
+	static const int FRESH = 4; // middle slot holds a frame the host hasn't acquired yet
+
+	Slot slots[3];
+	int back; // emulation thread only
+	int front; // host thread only
+	std::atomic<int> middle;
+	unsigned int sequence; // emulation thread only
+
+	void reset()
+	{
+		for (Slot& slot : slots)
+			slot.frame.format = PINMAME_FRAME_NONE;
+		back = 0;
+		front = 1;
+		middle = 2;
+		sequence = 0;
+	}
+
+	void publish(double emuTime)
+	{
+		PinmameFrame& frame = slots[back].frame;
+		frame.sequence = ++sequence;
+		frame.emuTime = emuTime;
+		back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & 3;
+	}
+
+	const PinmameFrame& acquire()
+	{
+		if (middle.load(std::memory_order_relaxed) & FRESH)
+			front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+		return slots[front].frame;
+	}
+};
+
+struct DMDFrameSlot
+{
+	PinmameFrame frame;
+	unsigned char levels[DMD_MAXY*DMD_MAXX];
+	unsigned int rgb[DMD_MAXY*DMD_MAXX];
+};
+
+struct SegmentFrameSlot
+{
+	PinmameFrame frame;
+	unsigned short segments[CORE_SEGCOUNT];
+};
+
+static FrameTripleBuffer<DMDFrameSlot> dmdFrames;
+static FrameTripleBuffer<SegmentFrameSlot> segmentFrames;
+
 #if !defined(_WIN32) && !defined(_WIN64)
 const char* checkGameAlias(const char* aRomName) 
 {
@@ -119,7 +224,136 @@ const char* checkGameAlias(const char* aRomName)
 
 void OnSolenoid(int nSolenoid, int IsActive)
 {
-	printf("Solenoid: %d %s\n", nSolenoid, (IsActive > 0 ? "ON" : "OFF"));
+	const SolenoidCallback callback = solenoidCallback;
+	if (callback)
+		callback(nSolenoid, IsActive, timer_get_time());
+	else
+		printf("Solenoid: %d %s\n", nSolenoid, (IsActive > 0 ? "ON" : "OFF"));
+}
+
+void OnOutputsUpdated(void)
+{
+	const LampCallback lamp = lampCallback;
+	const GICallback gi = giCallback;
+
+	// pick up switch changes queued by the host since the last update
+	armScriptTimer();
+
+	if (!isGameReady || (!lamp && !gi))
+		return;
+
+	const double time = timer_get_time();
+	if (lamp)
+	{
+		vp_tChgLamps chgLamps;
+		const int uCount = vp_getChangedLamps(chgLamps);
+		for (int i = 0; i < uCount; i++)
+			lamp(chgLamps[i].lampNo, chgLamps[i].currStat, time);
+	}
+	if (gi)
+	{
+		vp_tChgGIs chgGIs;
+		const int uCount = vp_getChangedGI(chgGIs);
+		for (int i = 0; i < uCount; i++)
+			gi(chgGIs[i].giNo, chgGIs[i].currStat, time);
+	}
+}
+
+void OnDMDFrame(int width, int height, int shades)
+{
+	if (!isGameReady)
+		return;
+
+	const double time = timer_get_time();
+	const DMDFrameCallback callback = dmdFrameCallback;
+	if (callback)
+		callback(g_raw_dmdbuffer, width, height, time);
+
+	DMDFrameSlot& slot = dmdFrames.slots[dmdFrames.back];
+	memcpy(slot.levels, g_raw_dmdbuffer, width*height * sizeof(unsigned char));
+	memcpy(slot.rgb, g_raw_colordmdbuffer, width*height * sizeof(unsigned int));
+	slot.frame.format = (shades == 16) ? PINMAME_FRAME_SHADES16 : PINMAME_FRAME_SHADES4;
+	slot.frame.width = width;
+	slot.frame.height = height;
+	slot.frame.data = slot.levels;
+	slot.frame.rgb = slot.rgb;
+	dmdFrames.publish(time);
+}
+
+void OnSegmentFrame(const UINT16* segments, int count)
+{
+	// called for every video frame, only publish the ones that differ from the previous one
+	static unsigned short lastSegments[CORE_SEGCOUNT];
+	static int lastCount = 0;
+
+	if (!isGameReady)
+		return;
+	if (count > CORE_SEGCOUNT)
+		count = CORE_SEGCOUNT;
+	if (count == lastCount && segmentFrames.sequence != 0 && memcmp(segments, lastSegments, count * sizeof(unsigned short)) == 0)
+		return;
+	memcpy(lastSegments, segments, count * sizeof(unsigned short));
+	lastCount = count;
+
+	SegmentFrameSlot& slot = segmentFrames.slots[segmentFrames.back];
+	memcpy(slot.segments, segments, count * sizeof(unsigned short));
+	slot.frame.format = PINMAME_FRAME_SEGMENTS;
+	slot.frame.width = count;
+	slot.frame.height = 1;
+	slot.frame.data = slot.segments;
+	slot.frame.rgb = nullptr;
+	segmentFrames.publish(timer_get_time());
+}
+
+void OnSoundCommand(int boardNo, int cmd)
+{
+	const SoundCommandCallback callback = soundCommandCallback;
+	if (callback)
+		callback(boardNo, cmd, timer_get_time());
+}
+
+//============================================================
+//	Scripted input Section
+//============================================================
+
+// (re)arm scriptTimer for the next queued switch change or the stop time, whatever comes first
+static void armScriptTimer()
+{
+	if (!isGameReady || scriptTimer == nullptr)
+		return;
+
+	double next = (stopTime > 0.) ? stopTime : TIME_NEVER;
+	{
+		std::lock_guard<std::mutex> lock(switchQueueMutex);
+		if (!switchQueue.empty() && switchQueue.front().time < next)
+			next = switchQueue.front().time;
+	}
+
+	if (next >= scriptTimerExpire)
+		return;
+	scriptTimerExpire = next;
+	const double delay = next - timer_get_time();
+	timer_adjust(scriptTimer, (delay > 0.) ? delay : 0., 0, 0);
+}
+
+static void scriptTimerCallback(int param)
+{
+	const double time = timer_get_time() + TIME_IN_NSEC(1);
+	scriptTimerExpire = TIME_NEVER;
+
+	{
+		std::lock_guard<std::mutex> lock(switchQueueMutex);
+		while (!switchQueue.empty() && switchQueue.front().time <= time)
+		{
+			vp_putSwitch(switchQueue.front().slot, switchQueue.front().state ? 1 : 0);
+			switchQueue.pop_front();
+		}
+	}
+
+	if (stopTime > 0. && stopTime <= time)
+		trying_to_quit = 1;
+	else
+		armScriptTimer();
 }
 
 void OnStateChange(int nChange)
@@ -132,9 +366,16 @@ void OnStateChange(int nChange)
 		for (int i = 0; i < initialSwitchesToSet; ++i)
 			vp_putSwitch(initialSwitches[i*2], initialSwitches[i*2+1] ? 1 : 0);
 		initialSwitchesToSet = 0;
+
+		// the machine (re)starts, so do all its timers
+		scriptTimer = timer_alloc(scriptTimerCallback);
+		scriptTimerExpire = TIME_NEVER;
 	}
 
 	isGameReady = (nChange > 0);
+
+	if (isGameReady)
+		armScriptTimer();
 }
 
 
@@ -156,6 +397,16 @@ int GetGameNumFromString(char *name)
 		return gamenum;
 }
 
+// copies src to dst, leaves dst unchanged and returns false if src doesn't fit
+template <size_t N> static bool copyString(char (&dst)[N], const char* src)
+{
+	const size_t len = strlen(src);
+	if (len >= N)
+		return false;
+	memcpy(dst, src, len + 1);
+	return true;
+}
+
 char* composePath(const char* path, const char* file)
 {
 	size_t pathl = strlen(path);
@@ -181,6 +432,7 @@ void gameThread(int game_index=-1)
 	if (game_index == -1)
 		return;
 	/*int res =*/ run_game(game_index);
+	isGameThreadRunning = false;
 }
 
 
@@ -191,14 +443,62 @@ void gameThread(int game_index=-1)
 // Setup Functions
 // ---------------
 
-PINMAMEDLL_API void SetVPMPath(char* path)
+PINMAMEDLL_API bool SetVPMPath(char* path)
 {
-	strcpy_s(vpmPath, path);
+	return copyString(settings.vpmPath, path);
 }
 
 PINMAMEDLL_API void SetSampleRate(int sampleRate)
 {
-	sampleRate = sampleRate;
+	settings.sampleRate = sampleRate;
+}
+
+PINMAMEDLL_API void SetAudioLatency(int latencyMs)
+{
+	settings.audioLatency = latencyMs;
+}
+
+PINMAMEDLL_API void SetThrottle(bool throttle)
+{
+	settings.throttle = throttle;
+}
+
+PINMAMEDLL_API void SetBootSnapshot(int bootTimeMs)
+{
+	settings.bootSnapshotTime = bootTimeMs;
+}
+
+PINMAMEDLL_API void SetRomCache(bool enable)
+{
+	settings.romCache = enable;
+}
+
+PINMAMEDLL_API void SetDCSCache(bool enable)
+{
+	settings.dcsCache = enable;
+}
+
+PINMAMEDLL_API void SetIdleSkip(bool enable)
+{
+	settings.idleSkip = enable;
+}
+
+PINMAMEDLL_API bool SetPerfCounters(bool enable, const char* traceFile)
+{
+	if (!copyString(settings.perfTrace, traceFile ? traceFile : ""))
+		return false;
+	settings.perfCounters = enable;
+	return true;
+}
+
+PINMAMEDLL_API bool SetDMDRecording(const char* fileName)
+{
+	return copyString(settings.dmdRecord, fileName ? fileName : "");
+}
+
+PINMAMEDLL_API bool SetNVRAMPath(const char* path)
+{
+	return copyString(settings.nvramPath, path ? path : "");
 }
 
 
@@ -216,9 +516,11 @@ PINMAMEDLL_API int StartThreadedGame(char* gameNameOrg, bool showConsole)
 #endif
 	trying_to_quit = 0;
 
+	if (!copyString(g_szGameName, gameNameOrg))
+		return -1;
+
 	rc = cli_rc_create();
 
-	strcpy_s(g_szGameName, gameNameOrg);
 	const char* const gameName = checkGameAlias(g_szGameName);
 
 	const int game_index = GetGameNumFromString(const_cast<char*>(gameName));
@@ -227,32 +529,52 @@ PINMAMEDLL_API int StartThreadedGame(char* gameNameOrg, bool showConsole)
 
 	//options.skip_disclaimer = 1;
 	//options.skip_gameinfo = 1;
-	options.samplerate = sampleRate;
+	options.samplerate = settings.sampleRate;
+	// no console to press a key in after missing ROMs
+	options.gui_host = 1;
+	options.boot_snapshot_time = settings.bootSnapshotTime / 1000.;
 
 #if defined(_WIN32) || defined(_WIN64)
 	win_timer_enable(1);
 #endif
 	g_fPause = 0;
 
-	set_option("throttle", "1", 0);
+	set_option("throttle", settings.throttle ? "1" : "0", 0);
+	// video.c forces throttling back on after fastfrms frames, -1 keeps it off for good
+	fastfrms = settings.throttle ? 0 : -1;
+	set_option("romcache", settings.romCache ? "1" : "0", 0);
+	set_option("dcs_cache", settings.dcsCache ? "1" : "0", 0);
+	set_option("idle_skip", settings.idleSkip ? "1" : "0", 0);
+	set_option("perfcounters", settings.perfCounters ? "1" : "0", 0);
+	set_option("perftrace", settings.perfTrace, 0);
+	set_option("dmdrecord", settings.dmdRecord, 0);
 	set_option("sleep", "1", 0);
 	set_option("autoframeskip", "0", 0);
 	set_option("skip_gameinfo", "1", 0);
 	set_option("skip_disclaimer", "1", 0);
 
+	char audioLatency[16];
+	sprintf(audioLatency, "%d", settings.audioLatency);
+	set_option("audio_latency", audioLatency, 0);
+
+	const char* const vpmPath = settings.vpmPath;
 	printf("VPM path: %s\n", vpmPath);
 	setPath(FILETYPE_ROM, composePath(vpmPath, "roms"));
-	setPath(FILETYPE_NVRAM, composePath(vpmPath, "nvram"));
+	setPath(FILETYPE_NVRAM, settings.nvramPath[0] ? composePath(settings.nvramPath, "") : composePath(vpmPath, "nvram"));
 	setPath(FILETYPE_SAMPLE, composePath(vpmPath, "samples"));
 	setPath(FILETYPE_CONFIG, composePath(vpmPath, "cfg"));
 	setPath(FILETYPE_HIGHSCORE, composePath(vpmPath, "hi"));
 	setPath(FILETYPE_INPUTLOG, composePath(vpmPath, "inp"));
 	setPath(FILETYPE_MEMCARD, composePath(vpmPath, "memcard"));
 	setPath(FILETYPE_STATE, composePath(vpmPath, "sta"));
+	setPath(FILETYPE_ROMCACHE, composePath(vpmPath, "romcache"));
 
 	vp_init();
+	dmdFrames.reset();
+	segmentFrames.reset();
 
 	printf("GameIndex: %d\n", game_index);
+	isGameThreadRunning = true;
 	pRunningGame = new std::thread(gameThread, game_index);
 
 	return game_index;
@@ -283,6 +605,12 @@ void StopThreadedGame(bool locking)
 
 	g_szGameName[0] = '\0';
 
+	{
+		std::lock_guard<std::mutex> lock(switchQueueMutex);
+		switchQueue.clear();
+	}
+	stopTime = 0.;
+
 #ifdef ENABLE_CONSOLE_DEBUG
 	CloseConsole();
 #endif
@@ -293,6 +621,56 @@ PINMAMEDLL_API bool IsGameReady()
 	return isGameReady;
 }
 
+PINMAMEDLL_API bool IsGameRunning()
+{
+	return pRunningGame != nullptr && isGameThreadRunning;
+}
+
+// Scripted input functions
+// ------------------------
+PINMAMEDLL_API void QueueSwitchChange(double emuTime, int slot, bool state)
+{
+	const QueuedSwitch sw = { emuTime, slot, state };
+	std::lock_guard<std::mutex> lock(switchQueueMutex);
+	// keep changes for the same time in the order they were queued
+	switchQueue.insert(std::upper_bound(switchQueue.begin(), switchQueue.end(), sw,
+		[](const QueuedSwitch& a, const QueuedSwitch& b) { return a.time < b.time; }), sw);
+}
+
+PINMAMEDLL_API void SetStopTime(double emuTime)
+{
+	stopTime = emuTime;
+}
+
+// Performance counter related functions
+// -------------------------------------
+PINMAMEDLL_API int GetPerfCounters(PinmamePerfCounter* buffer, int maxCount)
+{
+	static perfcount_entry entries[1024];
+	const int count = perfcount_get(entries, sizeof(entries) / sizeof(entries[0]));
+	if (buffer == nullptr)
+		return count;
+
+	const double scale = 1.0 / (double)osd_cycles_per_second();
+	int i;
+	for (i = 0; i < count && i < maxCount; i++)
+	{
+		buffer[i].type = entries[i].type;
+		buffer[i].cpuNum = entries[i].cpunum;
+		buffer[i].func = entries[i].func;
+		buffer[i].name = entries[i].name;
+		buffer[i].calls = entries[i].calls;
+		buffer[i].cycles = entries[i].cycles;
+		buffer[i].seconds = (double)entries[i].ticks * scale;
+	}
+	return i;
+}
+
+PINMAMEDLL_API void ResetPerfCounters()
+{
+	perfcount_reset();
+}
+
 // Pause related functions
 // -----------------------
 PINMAMEDLL_API void ResetGame()
@@ -340,10 +718,46 @@ PINMAMEDLL_API int GetRawDMDPixels(unsigned char* buffer)
 	if (!isGameReady || g_raw_dmdx == ~0u || g_raw_dmdy == ~0u)
 		return -1;
 	memcpy(buffer, g_raw_dmdbuffer, g_raw_dmdx*g_raw_dmdy * sizeof(unsigned char));
+	memset(g_raw_dmd_dirtyrows, 0, sizeof(g_raw_dmd_dirtyrows));
 	g_needs_DMD_update = 0;
 	return g_raw_dmdx*g_raw_dmdy;
 }
 
+PINMAMEDLL_API int GetRawDMDChangedRows(unsigned char* buffer, unsigned char* changedRows)
+{
+	if (!isGameReady || g_raw_dmdx == ~0u || g_raw_dmdy == ~0u)
+		return -1;
+	int count = 0;
+	for (unsigned int y = 0; y < g_raw_dmdy; y++)
+	{
+		changedRows[y] = g_raw_dmd_dirtyrows[y];
+		if (changedRows[y])
+		{
+			g_raw_dmd_dirtyrows[y] = 0;
+			memcpy(buffer + y*g_raw_dmdx, g_raw_dmdbuffer + y*g_raw_dmdx, g_raw_dmdx * sizeof(unsigned char));
+			count++;
+		}
+	}
+	g_needs_DMD_update = 0;
+	return count;
+}
+
+PINMAMEDLL_API bool AcquireDMDFrame(PinmameFrame* frame)
+{
+	if (!isGameReady)
+		return false;
+	*frame = dmdFrames.acquire();
+	return frame->format != PINMAME_FRAME_NONE;
+}
+
+PINMAMEDLL_API bool AcquireSegmentFrame(PinmameFrame* frame)
+{
+	if (!isGameReady)
+		return false;
+	*frame = segmentFrames.acquire();
+	return frame->format != PINMAME_FRAME_NONE;
+}
+
 
 // Audio related functions
 // -----------------------
@@ -458,6 +872,51 @@ PINMAMEDLL_API int GetChangedGIs(int* changedStates)
 	return uCount;
 }
 
+// Sub-frame output intensities
+// ----------------------------
+PINMAMEDLL_API int GetOutputIntensities(int type, unsigned short* buffer, int maxCount)
+{
+	if (!isGameReady || type < 0 || type >= CORE_PWM_GROUPS)
+		return -1;
+
+	const int count = core_pwm_getCount(type);
+	if (buffer != nullptr)
+		core_pwm_get16(type, 0, (maxCount < count) ? maxCount : count, buffer);
+	return count;
+}
+
+PINMAMEDLL_API bool SetOutputModel(int type, int first, int count, int model, float gain)
+{
+	return isGameReady && core_pwm_setModel(type, first, count, model, gain) != 0;
+}
+
+// Output callbacks
+// ----------------
+PINMAMEDLL_API void SetSolenoidCallback(SolenoidCallback callback)
+{
+	solenoidCallback = callback;
+}
+
+PINMAMEDLL_API void SetLampCallback(LampCallback callback)
+{
+	lampCallback = callback;
+}
+
+PINMAMEDLL_API void SetGICallback(GICallback callback)
+{
+	giCallback = callback;
+}
+
+PINMAMEDLL_API void SetDMDFrameCallback(DMDFrameCallback callback)
+{
+	dmdFrameCallback = callback;
+}
+
+PINMAMEDLL_API void SetSoundCommandCallback(SoundCommandCallback callback)
+{
+	soundCommandCallback = callback;
+}
+
 //============================================================
 //	osd_init
 //============================================================
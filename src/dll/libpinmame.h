@@ -12,8 +12,38 @@
 	// Setup related functions
 	// -----------------------
 	// Call these before doing anything else
-	PINMAMEDLL_API void SetVPMPath(char* path);
+	// The path and file name setters return false and keep the previous setting if the name is too long
+	PINMAMEDLL_API bool SetVPMPath(char* path);
 	PINMAMEDLL_API void SetSampleRate(int sampleRate);
+	// target amount of audio (in msecs) buffered between the emulation and GetPendingAudioSamples*,
+	// the emulation speed is adjusted to keep it there (default 40)
+	PINMAMEDLL_API void SetAudioLatency(int latencyMs);
+	// false runs the emulation as fast as possible instead of in realtime, e.g. for batch/regression runs (default true)
+	PINMAMEDLL_API void SetThrottle(bool throttle);
+	// save the machine state bootTimeMs of emulated time after power on to sta/<game>-boot.sta and restore it
+	// on later starts instead of booting again. The file is only used if the ROMs, the NVRAM and the PinMAME
+	// version still match, and holds the same state as the .sta save states. Only used for games flagged
+	// GAME_SUPPORTS_SAVE, which register their complete state; no pinball driver does so yet (default 0: off)
+	PINMAMEDLL_API void SetBootSnapshot(int bootTimeMs);
+	// keep the unzipped ROMs in romcache/, so that unchanged sets load without unzipping and hashing them
+	// again, at the cost of the disk space of the unzipped ROMs (default false)
+	PINMAMEDLL_API void SetRomCache(bool enable);
+	// keep the samples of recently decoded DCS sound frames (about 2 MB), so that sounds which are played
+	// again cost less CPU time. The output is the same as without the cache (default false)
+	PINMAMEDLL_API void SetDCSCache(bool enable);
+	// let the main CPU of WPC, S11 and DE games sleep until the next interrupt when it spins in a loop that only
+	// polls RAM, the skipped cycles are reported as perf counters of type PINMAME_PERF_SKIPPED. Changes the timing slightly, so
+	// runs are reproducible with the same setting only (default false)
+	PINMAMEDLL_API void SetIdleSkip(bool enable);
+	// count the time spent per CPU, memory handler, timer callback and video/sound update, see GetPerfCounters;
+	// traceFile (may be NULL) also gets a Chrome/Perfetto trace of the CPU timeslices, timers and updates (default false)
+	PINMAMEDLL_API bool SetPerfCounters(bool enable, const char* traceFile);
+	// append every DMD sub-frame (the bitplanes of each display refresh, WPC, DE, SE, GTS3, SAM and Alvin G) with its
+	// emulated time to fileName, compressed by a background thread, see src/wpc/dmdrec.c for the format (default NULL: off)
+	PINMAMEDLL_API bool SetDMDRecording(const char* fileName);
+	// keep the NVRAM files in path instead of <VPM path>nvram/, e.g. a new directory for reproducible runs that
+	// start from a factory reset state. The directory is created once a file is written (default NULL: <VPM path>nvram/)
+	PINMAMEDLL_API bool SetNVRAMPath(const char* path);
 
 	// Game related functions
 	// ----------------------
@@ -23,6 +53,18 @@
 	PINMAMEDLL_API void ResetGame();
 	// IsGameReady will only be true after a 'while', i.e. after calling StartThreadedGame plus X msecs!
 	PINMAMEDLL_API bool IsGameReady();
+	// true from StartThreadedGame until the game thread has ended, e.g. also false again if the game failed to start
+	PINMAMEDLL_API bool IsGameRunning();
+
+	// Scripted input functions
+	// ------------------------
+	// Queue a switch change that is applied from the emulation thread exactly when the emulated time
+	// (in seconds, same as the emuTime of the output callbacks) reaches emuTime, so a script gives
+	// the same run independent of the host speed. Can already be called before starting the game,
+	// the queue is cleared by StopThreadedGame.
+	PINMAMEDLL_API void QueueSwitchChange(double emuTime, int slot, bool state);
+	// let the game quit by itself once the emulated time reaches emuTime (0 = run until StopThreadedGame)
+	PINMAMEDLL_API void SetStopTime(double emuTime);
 
 	// ALL THE FOLLOWING FUNCTIONS WILL ONLY HAVE A MEANINGFUL EFFECT IF IsGameReady() IS TRUE!
 
@@ -32,6 +74,38 @@
 	PINMAMEDLL_API void Continue();
 	PINMAMEDLL_API bool IsPaused();
 
+	// Performance counter related functions
+	// -------------------------------------
+	// Only count while enabled with SetPerfCounters, the counters of a game stay available after it stopped until
+	// the next one is started. Times include nested entries, e.g. a CPU includes the memory handlers it calls;
+	// func is the address of the handler/callback (to be looked up in the map file)
+	enum
+	{
+		PINMAME_PERF_CPU = 0, // CPU timeslices
+		PINMAME_PERF_READ = 1, // memory read handler
+		PINMAME_PERF_WRITE = 2, // memory write handler
+		PINMAME_PERF_TIMER = 3, // timer callback
+		PINMAME_PERF_VIDEO = 4, // video update
+		PINMAME_PERF_SOUND = 5, // sound update, including the mixer
+		PINMAME_PERF_STREAM = 6, // sound stream (chip)
+		PINMAME_PERF_CONTEXT = 7, // CPU context swap
+		PINMAME_PERF_SKIPPED = 8, // cycles skipped while a CPU was suspended (calls = timeslices)
+	};
+	struct PinmamePerfCounter
+	{
+		int type; // PINMAME_PERF_*
+		int cpuNum; // -1 if none, mixer channel for sound streams
+		const void* func;
+		const char* name; // CPU type (CPU timeslices, context swaps and skipped cycles) or sound stream name, NULL otherwise
+		unsigned long long calls;
+		unsigned long long cycles; // emulated cycles, CPU and skipped cycles entries only
+		double seconds;
+	};
+	// needs pre-allocated maxCount*sizeof(PinmamePerfCounter) buffer (pass NULL to query the count)
+	// returns the number of counters copied
+	PINMAMEDLL_API int  GetPerfCounters(PinmamePerfCounter* buffer, int maxCount);
+	PINMAMEDLL_API void ResetPerfCounters();
+
 	// DMD related functions
 	// ---------------------
 	PINMAMEDLL_API bool NeedsDMDUpdate();
@@ -40,6 +114,38 @@
 	// needs pre-allocated GetRawDMDWidth()*GetRawDMDHeight()*sizeof(unsigned char) buffer
 	// returns GetRawDMDWidth()*GetRawDMDHeight()
 	PINMAMEDLL_API int GetRawDMDPixels(unsigned char* buffer);
+	// same as GetRawDMDPixels, but only copies the rows that changed since the last call of either function,
+	// so buffer has to keep the previous frame. changedRows needs GetRawDMDHeight() bytes and is set to 1 for each copied row.
+	// returns the number of changed rows
+	PINMAMEDLL_API int GetRawDMDChangedRows(unsigned char* buffer, unsigned char* changedRows);
+
+	// Frame related functions
+	// -----------------------
+	// Copy free alternative to the raw DMD functions above, also for alphanumeric segment displays:
+	// the emulation thread publishes each completed frame into a triple buffer and Acquire*Frame hands out
+	// the latest one. Its data stays valid and unchanged until the next Acquire*Frame call for the same
+	// display, so only call these from one host thread. sequence counts the published frames from 1 on,
+	// an unchanged sequence means that there was no new frame since the last call.
+	enum
+	{
+		PINMAME_FRAME_NONE = 0,
+		PINMAME_FRAME_SHADES4 = 1, // DMD with 4 shades, 2 shade DMDs are reported as 4 shade ones
+		PINMAME_FRAME_SHADES16 = 2, // DMD with 16 shades (GTS3, SAM, ...)
+		PINMAME_FRAME_SEGMENTS = 3, // segment displays
+	};
+	struct PinmameFrame
+	{
+		int format; // PINMAME_FRAME_*
+		int width; // DMD dots, number of segment positions for segment displays
+		int height; // DMD dots, 1 for segment displays
+		unsigned int sequence;
+		double emuTime; // emulated time in seconds the frame was completed at
+		const void* data; // DMD: width*height unsigned char brightness levels (0..100, same as GetRawDMDPixels), segments: width unsigned short segment words
+		const unsigned int* rgb; // DMD: width*height colors (0x00BBGGRR), NULL for segment displays
+	};
+	// return false if the game isn't ready or no frame was completed yet
+	PINMAMEDLL_API bool AcquireDMDFrame(PinmameFrame* frame);
+	PINMAMEDLL_API bool AcquireSegmentFrame(PinmameFrame* frame);
 
 
 	// Audio related functions
@@ -79,3 +185,31 @@
 	// needs pre-allocated GetMaxGIStrings()*sizeof(int)*2 buffer (i.e. for each GI: giNo and currStat)
 	// returns actually changed GI strings
 	PINMAMEDLL_API int GetChangedGIs(int* changedStates);
+
+	// Sub-frame output intensities
+	// ----------------------------
+	// The outputs are sampled at the hardware strobe rate and run through a bulb or LED model (WPC and SAM only so far).
+	// type: 0 = lamps (col*8+row), 1 = solenoids (solNo-1), 2 = GI strings
+	// writes up to maxCount 16 bit intensities (0 = off, 65535 = fully lit), returns the number of outputs of that type or -1
+	PINMAMEDLL_API int GetOutputIntensities(int type, unsigned short* buffer, int maxCount);
+	// model: 0 = #44/#555 bulb, 1 = #906 flasher bulb, 2 = LED; gain scales the drive level, e.g. 8 for a lamp strobed 1/8 of the time
+	// the change is applied with the next sample on the emulation thread; call it from one thread only
+	// returns false if no game is running, the arguments are invalid or too many changes are pending
+	PINMAMEDLL_API bool SetOutputModel(int type, int first, int count, int model, float gain);
+
+	// Output callbacks
+	// ----------------
+	// Called from the emulation thread when an output changes, emuTime is the emulated time in seconds.
+	// Pass NULL to unregister. Lamp and GI callbacks share the change tracking with GetChangedLamps/GetChangedGIs,
+	// so don't mix both ways for the same output type.
+	typedef void (*SolenoidCallback)(int solNo, int isActive, double emuTime);
+	typedef void (*LampCallback)(int lampNo, int currStat, double emuTime);
+	typedef void (*GICallback)(int giNo, int currStat, double emuTime);
+	// frame is GetRawDMDWidth()*GetRawDMDHeight() bytes, only valid for the duration of the call
+	typedef void (*DMDFrameCallback)(const unsigned char* frame, int width, int height, double emuTime);
+	typedef void (*SoundCommandCallback)(int boardNo, int cmd, double emuTime);
+	PINMAMEDLL_API void SetSolenoidCallback(SolenoidCallback callback);
+	PINMAMEDLL_API void SetLampCallback(LampCallback callback);
+	PINMAMEDLL_API void SetGICallback(GICallback callback);
+	PINMAMEDLL_API void SetDMDFrameCallback(DMDFrameCallback callback);
+	PINMAMEDLL_API void SetSoundCommandCallback(SoundCommandCallback callback);
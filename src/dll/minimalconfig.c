@@ -80,6 +80,8 @@ struct rc_option pinmame_opts[] = {
         { "dmd_blue0", NULL, rc_int, &pmoptions.dmd_blue0, "0", 0, 255, NULL, "Colorized DMD: 0%: Blue" },
         { "dmd_opacity", NULL, rc_int, &pmoptions.dmd_opacity, "100", 0, 100, NULL, "DMD opacity" },
         { "resampling_quality", NULL, rc_int, &pmoptions.resampling_quality, "0", 0, 1, NULL, "Quality of the resampling implementation (0=Fast,1=Normal)" },
+        { "dcs_cache", NULL, rc_bool, &pmoptions.dcs_cache, "0", 0, 0, NULL, "Cache decoded DCS sound frames (more memory, less CPU)" },
+        { "idle_skip", NULL, rc_bool, &pmoptions.idle_skip, "0", 0, 0, NULL, "Let the main CPU sleep in idle loops until the next interrupt (WPC, S11, DE)" },
 #if defined(VPINMAME_ALTSOUND) || defined(VPINMAME_PINSOUND)
         { "sound_mode", NULL, rc_int, &pmoptions.sound_mode, "0", 0, 3, NULL, "Sound processing mode (PinMAME, Alternative, PinSound, PinSound + Recordings)" },
 #endif
@@ -275,6 +277,10 @@ struct rc_option core_opts[] = {
         { "skip_disclaimer", NULL, rc_bool, &options.skip_disclaimer, "0", 0, 0, NULL, "skip displaying the disclaimer screen" },
         { "skip_gameinfo", NULL, rc_bool, &options.skip_gameinfo, "0", 0, 0, NULL, "skip displaying the game info screen" },
         { "crconly", NULL, rc_bool, &options.crc_only, "0", 0, 0, NULL, "use only CRC for all integrity checks" },
+        { "romcache", NULL, rc_bool, &options.rom_cache, "0", 0, 0, NULL, "keep the unzipped ROMs in the ROM cache directory for faster loading" },
+        { "perfcounters", NULL, rc_bool, &options.perf_counters, "0", 0, 0, NULL, "count the time spent per CPU, memory handler, timer and video/sound update" },
+        { "perftrace", NULL, rc_string, &options.perf_trace, NULL, 0, 0, NULL, "write a Chrome/Perfetto trace of the performance counters to this file" },
+        { "dmdrecord", NULL, rc_string, &options.dmd_record, NULL, 0, 0, NULL, "append all DMD sub-frames with their emulated time to this file" },
         { "bios", NULL, rc_string, &options.bios, "default", 0, 14, NULL, "change system bios" },
         { "at91jit", NULL, rc_int, &options.at91jit, "1", 0, 33554432, NULL, "at91 CPU JIT compiler enabled" },
 
@@ -0,0 +1,243 @@
+// license:BSD-3-Clause
+
+// Headless batch runner for regression testing:
+// runs one game unthrottled and without video/audio output, feeds it a switch script
+// with emulated time stamps and writes all solenoid/lamp/GI/DMD/sound command changes
+// (with emulated time stamps) to a trace file, plus a hash of the final NVRAM. Each run starts
+// from empty NVRAM in a new directory (<path>nvram_batch/<start time>/<game>/), so the trace
+// only depends on the game and the script.
+//
+// Script format, one entry per line, '#' starts a comment:
+//   <emuTime> <switchNo> <0|1>   set a switch at emulated time emuTime (in seconds)
+//   <emuTime> stop               end the run at emulated time emuTime
+
+#include "libpinmame.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <thread>
+#include <chrono>
+
+static FILE* trace = nullptr;
+
+static unsigned int fnv1a32(const unsigned char* data, size_t size)
+{
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ data[i]) * 16777619u;
+	return hash;
+}
+
+// all callbacks are invoked from the emulation thread, so they can write the trace without locking
+static void onSolenoid(int solNo, int isActive, double emuTime)
+{
+	fprintf(trace, "%.6f SOL %d %d\n", emuTime, solNo, isActive);
+}
+
+static void onLamp(int lampNo, int currStat, double emuTime)
+{
+	fprintf(trace, "%.6f LAMP %d %d\n", emuTime, lampNo, currStat);
+}
+
+static void onGI(int giNo, int currStat, double emuTime)
+{
+	fprintf(trace, "%.6f GI %d %d\n", emuTime, giNo, currStat);
+}
+
+static void onDMDFrame(const unsigned char* frame, int width, int height, double emuTime)
+{
+	fprintf(trace, "%.6f DMD %dx%d %08x\n", emuTime, width, height, fnv1a32(frame, (size_t)width*height));
+}
+
+static void onSoundCommand(int boardNo, int cmd, double emuTime)
+{
+	fprintf(trace, "%.6f SND %d %02x\n", emuTime, boardNo, cmd);
+}
+
+// returns the stop time found in the script (0 if none), or -1 on error
+static double loadScript(const char* fileName)
+{
+	FILE* f = fopen(fileName, "r");
+	if (f == nullptr)
+	{
+		fprintf(stderr, "can't open script %s\n", fileName);
+		return -1.;
+	}
+
+	double stop = 0.;
+	char line[256];
+	int lineNo = 0;
+	while (fgets(line, sizeof(line), f))
+	{
+		lineNo++;
+		char* const comment = strchr(line, '#');
+		if (comment)
+			*comment = '\0';
+
+		double time;
+		int sw, state;
+		char word[16];
+		if (sscanf(line, "%lf %d %d", &time, &sw, &state) == 3)
+			QueueSwitchChange(time, sw, state != 0);
+		else if (sscanf(line, "%lf %15s", &time, word) == 2 && strcmp(word, "stop") == 0)
+			stop = time;
+		else if (sscanf(line, "%15s", word) == 1)
+		{
+			fprintf(stderr, "%s(%d): syntax error\n", fileName, lineNo);
+			fclose(f);
+			return -1.;
+		}
+	}
+	fclose(f);
+	return stop;
+}
+
+// FNV-1a 64 of the NVRAM file the game wrote on exit
+static bool hashNVRAM(const std::string& fileName, unsigned long long& hash)
+{
+	FILE* f = fopen(fileName.c_str(), "rb");
+	if (f == nullptr)
+		return false;
+
+	hash = 14695981039346656037ull;
+	int c;
+	while ((c = fgetc(f)) != EOF)
+		hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+	fclose(f);
+	return true;
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: pinmamebatch [options] <game>\n"
+		"  -p <path>     PinMAME path containing roms/, samples/, ... (default ./)\n"
+		"  -s <script>   switch script\n"
+		"  -t <seconds>  emulated time to run, overrides a stop entry of the script\n"
+		"  -o <file>     trace output (default <game>.trace)\n"
+		"  -r <rate>     sample rate, 0 skips sound emulation (default 48000)\n");
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = "./";
+	const char* scriptName = nullptr;
+	const char* traceName = nullptr;
+	const char* gameName = nullptr;
+	double runTime = 0.;
+	int sampleRate = 48000;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0' && i + 1 < argc)
+		{
+			switch (argv[i][1])
+			{
+			case 'p': path = argv[++i]; break;
+			case 's': scriptName = argv[++i]; break;
+			case 't': runTime = atof(argv[++i]); break;
+			case 'o': traceName = argv[++i]; break;
+			case 'r': sampleRate = atoi(argv[++i]); break;
+			default: usage(); return 2;
+			}
+		}
+		else if (gameName == nullptr && argv[i][0] != '-')
+			gameName = argv[i];
+		else
+		{
+			usage();
+			return 2;
+		}
+	}
+	if (gameName == nullptr)
+	{
+		usage();
+		return 2;
+	}
+	if (path.back() != '/' && path.back() != '\\')
+		path += '/';
+
+	if (scriptName)
+	{
+		const double stop = loadScript(scriptName);
+		if (stop < 0.)
+			return 2;
+		if (runTime <= 0.)
+			runTime = stop;
+	}
+	if (runTime <= 0.)
+	{
+		fprintf(stderr, "no run time given (-t or a stop entry in the script)\n");
+		return 2;
+	}
+
+	char nvramRoot[64];
+	sprintf(nvramRoot, "nvram_batch/%lld/", (long long)time(nullptr));
+	const std::string nvramPath = path + nvramRoot + gameName;
+	const std::string nvramFile = nvramPath + "/" + gameName + ".nv";
+	unsigned long long hash;
+	if (hashNVRAM(nvramFile, hash))
+	{
+		fprintf(stderr, "%s already exists, the run must start from empty NVRAM\n", nvramFile.c_str());
+		return 2;
+	}
+
+	const std::string defaultTraceName = std::string(gameName) + ".trace";
+	trace = fopen(traceName ? traceName : defaultTraceName.c_str(), "w");
+	if (trace == nullptr)
+	{
+		fprintf(stderr, "can't create trace file\n");
+		return 2;
+	}
+
+	if (!SetVPMPath(const_cast<char*>(path.c_str())) || !SetNVRAMPath(nvramPath.c_str()))
+	{
+		fprintf(stderr, "path too long\n");
+		fclose(trace);
+		return 2;
+	}
+	SetSampleRate(sampleRate);
+	SetThrottle(false);
+	SetStopTime(runTime);
+
+	SetSolenoidCallback(onSolenoid);
+	SetLampCallback(onLamp);
+	SetGICallback(onGI);
+	SetDMDFrameCallback(onDMDFrame);
+	SetSoundCommandCallback(onSoundCommand);
+
+	const auto start = std::chrono::steady_clock::now();
+	if (StartThreadedGame(const_cast<char*>(gameName)) < 0)
+	{
+		fprintf(stderr, "unknown game %s\n", gameName);
+		fclose(trace);
+		return 1;
+	}
+
+	// nothing to do here but wait, the game quits by itself at the stop time
+	while (IsGameRunning())
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	const bool started = IsGameReady();
+	StopThreadedGame(true);
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (!started)
+	{
+		fprintf(stderr, "%s failed to start\n", gameName);
+		fclose(trace);
+		return 1;
+	}
+
+	if (hashNVRAM(nvramFile, hash))
+		fprintf(trace, "NVRAM %016llx\n", hash);
+	else
+		fprintf(trace, "NVRAM none\n");
+	fclose(trace);
+
+	fprintf(stderr, "%s: %.2f emulated seconds in %.2f seconds (%.1fx realtime)\n",
+		gameName, runTime, elapsed, (elapsed > 0.) ? runTime / elapsed : 0.);
+	return 0;
+}
@@ -0,0 +1,264 @@
+// license:BSD-3-Clause
+
+// Benchmark suite: runs one representative game per hardware family unthrottled for a fixed
+// amount of emulated time with a fixed switch script. Each run starts from empty NVRAM in a
+// new directory (<path>nvram_bench/<start time>/<game>-<run>/), so the runs are deterministic
+// and only the host time differs. Reports the emulated seconds per wall clock second, timed
+// from IsGameReady() on and with the performance counters off, and compares it against a
+// baseline file written by an earlier run. A second run with the counters on (see
+// SetPerfCounters, skipped with -q) then reports the share of the wall clock time spent per
+// CPU, per sound chip and in CPU context swaps, and the cycles skipped in idle loops (-i, see
+// SetIdleSkip).
+//
+// Baseline format, one entry per line: <game> <emulated seconds per wall clock second>
+
+#include "libpinmame.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <ctime>
+
+struct BenchSwitch
+{
+	double time;
+	int sw;
+	bool state;
+};
+
+struct BenchGame
+{
+	const char* family;
+	const char* game;
+	// switches closed at power on (balls in the trough) and a start button press,
+	// only given where the switch numbers are known from the simulator sources
+	BenchSwitch script[8];
+};
+
+static const BenchGame benchGames[] =
+{
+	{ "S11",     "grand_l4", { { -1. } } },
+	{ "WPC89",   "fh_l9",    { { 0., 63, true }, { 0., 72, true }, { 0., 74, true }, { 20., 13, true }, { 20.1, 13, false }, { -1. } } },
+	{ "WPCDMD",  "t2_l8",    { { 0., 15, true }, { 0., 16, true }, { 0., 17, true }, { 20., 13, true }, { 20.1, 13, false }, { -1. } } },
+	{ "WPC95",   "afm_113",  { { 0., 32, true }, { 0., 33, true }, { 0., 34, true }, { 0., 35, true }, { 20., 13, true }, { 20.1, 13, false }, { -1. } } },
+	{ "DE",      "hook_408", { { -1. } } },
+	{ "GTS3",    "stargate", { { -1. } } },
+	{ "SAM",     "wof_500",  { { -1. } } },
+	{ "Capcom",  "pmv112",   { { -1. } } },
+	{ "AlvinG",  "agsoccer", { { -1. } } },
+};
+
+static std::map<std::string, double> loadBaseline(const char* fileName)
+{
+	std::map<std::string, double> baseline;
+	FILE* f = fopen(fileName, "r");
+	if (f == nullptr)
+		return baseline;
+
+	char line[256];
+	while (fgets(line, sizeof(line), f))
+	{
+		char game[64];
+		double speed;
+		if (line[0] != '#' && sscanf(line, "%63s %lf", game, &speed) == 2)
+			baseline[game] = speed;
+	}
+	fclose(f);
+	return baseline;
+}
+
+// returns the wall clock seconds from IsGameReady() until the stop time, or 0 if the game didn't start
+static double runGame(const BenchGame& bench, double runTime, const std::string& nvramPath)
+{
+	if (!SetNVRAMPath(nvramPath.c_str()))
+		return 0.;
+	for (const BenchSwitch* s = bench.script; s->time >= 0.; s++)
+		QueueSwitchChange(s->time, s->sw, s->state);
+	SetStopTime(runTime);
+
+	if (StartThreadedGame(const_cast<char*>(bench.game)) < 0)
+	{
+		StopThreadedGame(true);
+		return 0.;
+	}
+	// only time the emulation, not loading and checking the ROMs
+	while (IsGameRunning() && !IsGameReady())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	const bool started = IsGameReady();
+	const auto start = std::chrono::steady_clock::now();
+	while (IsGameRunning())
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	StopThreadedGame(true);
+	return started && elapsed > 0. ? elapsed : 0.;
+}
+
+// the counters of the last run stay available after the game stopped
+static void printPerfCounters(double elapsed, double runTime)
+{
+	const int count = GetPerfCounters(nullptr, 0);
+	std::vector<PinmamePerfCounter> counters(count);
+	GetPerfCounters(counters.data(), count);
+
+	for (const PinmamePerfCounter& c : counters)
+		if (c.type == PINMAME_PERF_CPU)
+			printf("    CPU %d %-12s %5.1f%%  %.2f MHz emulated\n", c.cpuNum, c.name ? c.name : "?",
+				100. * c.seconds / elapsed, (double)c.cycles / runTime / 1e6);
+
+	// register file swaps between CPUs sharing a core, e.g. the WPC main and sound 6809
+	for (const PinmamePerfCounter& c : counters)
+		if (c.type == PINMAME_PERF_CONTEXT)
+			printf("    CPU %d context swaps %5.1f%%  %.0f per emulated second\n", c.cpuNum,
+				100. * c.seconds / elapsed, (double)c.calls / runTime);
+
+	// cycles a CPU slept through, i.e. idle loops (and spin loops of the DCS speedup)
+	for (const PinmamePerfCounter& c : counters)
+		if (c.type == PINMAME_PERF_SKIPPED && c.cycles > 0)
+			printf("    CPU %d skipped %.2f MHz emulated\n", c.cpuNum, (double)c.cycles / runTime / 1e6);
+
+	// sound chips, summing the channels of each stream
+	std::map<std::string, double> chips;
+	for (const PinmamePerfCounter& c : counters)
+		if (c.type == PINMAME_PERF_STREAM)
+			chips[c.name ? c.name : "?"] += c.seconds;
+	for (const auto& chip : chips)
+		printf("    %-18s %5.1f%%\n", chip.first.c_str(), 100. * chip.second / elapsed);
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: pinmamebench [options] [family|game ...]\n"
+		"  -p <path>     PinMAME path containing roms/, nvram/, ... (default ./)\n"
+		"  -t <seconds>  emulated time to run each game (default 60)\n"
+		"  -b <file>     compare against this baseline\n"
+		"  -w <file>     write the results as a new baseline\n"
+		"  -i            skip idle loops of the main CPU\n"
+		"  -q            only measure the speed, skip the run with the performance counters\n"
+		"without families or games, all of these are run:\n");
+	for (const BenchGame& bench : benchGames)
+		fprintf(stderr, "  %-8s %s\n", bench.family, bench.game);
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = "./";
+	const char* baselineName = nullptr;
+	const char* writeName = nullptr;
+	double runTime = 60.;
+	bool idleSkip = false;
+	bool perfRun = true;
+	std::vector<const char*> selected;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-i") == 0)
+			idleSkip = true;
+		else if (strcmp(argv[i], "-q") == 0)
+			perfRun = false;
+		else if (argv[i][0] == '-' && argv[i][1] != '\0' && argv[i][2] == '\0' && i + 1 < argc)
+		{
+			switch (argv[i][1])
+			{
+			case 'p': path = argv[++i]; break;
+			case 't': runTime = atof(argv[++i]); break;
+			case 'b': baselineName = argv[++i]; break;
+			case 'w': writeName = argv[++i]; break;
+			default: usage(); return 2;
+			}
+		}
+		else if (argv[i][0] != '-')
+			selected.push_back(argv[i]);
+		else
+		{
+			usage();
+			return 2;
+		}
+	}
+	if (runTime <= 0.)
+	{
+		usage();
+		return 2;
+	}
+	if (path.back() != '/' && path.back() != '\\')
+		path += '/';
+
+	const std::map<std::string, double> baseline = baselineName ? loadBaseline(baselineName) : std::map<std::string, double>();
+
+	if (!SetVPMPath(const_cast<char*>(path.c_str())))
+	{
+		fprintf(stderr, "path too long\n");
+		return 2;
+	}
+	SetSampleRate(48000);
+	SetThrottle(false);
+	SetIdleSkip(idleSkip);
+
+	char nvramRoot[64];
+	sprintf(nvramRoot, "nvram_bench/%lld/", (long long)time(nullptr));
+
+	std::vector<std::pair<std::string, double>> results;
+	int failed = 0;
+	for (const BenchGame& bench : benchGames)
+	{
+		if (!selected.empty())
+		{
+			bool found = false;
+			for (const char* name : selected)
+				found |= strcmp(name, bench.family) == 0 || strcmp(name, bench.game) == 0;
+			if (!found)
+				continue;
+		}
+
+		printf("%-8s %s\n", bench.family, bench.game);
+		fflush(stdout);
+		SetPerfCounters(false, nullptr);
+		const double elapsed = runGame(bench, runTime, path + nvramRoot + bench.game + "-1");
+		if (elapsed <= 0.)
+		{
+			printf("  failed to start (missing ROMs?)\n");
+			failed++;
+			continue;
+		}
+
+		const double speed = runTime / elapsed;
+		printf("  %.2fx realtime", speed);
+		const auto base = baseline.find(bench.game);
+		if (base != baseline.end() && base->second > 0.)
+			printf(", %+.1f%% vs. baseline (%.2fx)", 100. * (speed / base->second - 1.), base->second);
+		printf("\n");
+		fflush(stdout);
+		results.emplace_back(bench.game, speed);
+
+		// the counters slow the emulation down, so the breakdown comes from a separate run
+		if (perfRun)
+		{
+			SetPerfCounters(true, nullptr);
+			const double perfElapsed = runGame(bench, runTime, path + nvramRoot + bench.game + "-2");
+			if (perfElapsed > 0.)
+				printPerfCounters(perfElapsed, runTime);
+			fflush(stdout);
+		}
+	}
+
+	if (writeName)
+	{
+		FILE* f = fopen(writeName, "w");
+		if (f == nullptr)
+		{
+			fprintf(stderr, "can't create %s\n", writeName);
+			return 2;
+		}
+		fprintf(f, "# pinmamebench, %.0f emulated seconds per game\n", runTime);
+		for (const auto& result : results)
+			fprintf(f, "%s %.4f\n", result.first.c_str(), result.second);
+		fclose(f);
+	}
+
+	return failed ? 1 : 0;
+}
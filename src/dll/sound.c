@@ -2,9 +2,21 @@
 #include <stdio.h>
 #include "driver.h"
 #include "rc.h"
+#include "core.h"
 
 #include "sound.h"
 
+#if defined(_MSC_VER)
+ #include <intrin.h>
+#endif
+
+#ifndef MIN
+ #define MIN(x,y) ((x)<(y)?(x):(y))
+#endif
+#ifndef MAX
+ #define MAX(x,y) ((x)>(y)?(x):(y))
+#endif
+
 //============================================================
 //	GLOBAL VARIABLES
 //============================================================
@@ -18,16 +30,12 @@ extern int g_fPause;
 //	PARAMETERS
 //============================================================
 
-// the local buffer is what the stream buffer feeds from
-// note that this needs to be large enough to buffer at frameskip 11
-// for 30fps games like Tapper; we will scale the value down based
-// on the actual framerate of the game
-#define MAX_BUFFER_SIZE			(128 * 1024)
+// the ring buffer holds at least this many times the target latency,
+// so short stalls of the host or the emulation don't over/underrun it
+#define RING_LATENCY_FACTOR		4
 
-// this is the maximum number of extra samples we will ask for
-// per frame (I know this looks like a lot, but most of the
-// time it will generally be nowhere close to this)
-#define MAX_SAMPLE_ADJUST		16
+// but never less than this (in msecs), to cover a frame at low frame rates
+#define RING_MIN_MSECS			200
 
 
 //============================================================
@@ -42,19 +50,15 @@ static double				samples_per_frame;
 static double				samples_left_over;
 static UINT32				samples_this_frame;
 
-// sample rate adjustments
-static int					current_adjustment = 0;
-static int					writing_advance = 0;
+// target latency (in msecs) of the audio buffered between emulation and host
 static int					audio_latency;
-static int					lower_thresh;
-static int					upper_thresh;
 
-// sound options (none at this time)
+// sound options
 struct rc_option sound_opts[] =
 {
 	// name, shortname, type, dest, deflt, min, max, func, help
 	{ "Windows sound options", NULL, rc_seperator, NULL, NULL, 0, 0, NULL, NULL },
-	{ "audio_latency", NULL, rc_int, &audio_latency, "1", 1, 4, NULL, "set audio latency (increase to reduce glitches)" },
+	{ "audio_latency", NULL, rc_int, &audio_latency, "40", 5, 500, NULL, "set target audio latency in msecs (increase to reduce glitches)" },
 	{ NULL,	NULL, rc_end, NULL, NULL, 0, 0,	NULL, NULL }
 };
 
@@ -87,33 +91,46 @@ Of course that value is not necessarily an integer so at least a +/- 1
 adjustment is necessary to avoid drifting over time.
 */
 
-static int currentWritingBufferPos = 0;
-static int currentStreamingBufferPos = -1; // -1 means not ready
-static int streamingBufSize = -1; // Hold the data to be out using get pending
-static int stream_buffer_size;
+/*
+The stream is handed to the host through a single producer (emulation thread,
+osd_update_audio_stream) / single consumer (host thread, fillAudioBuffer) ring
+buffer. Both positions count sample frames (one sample per channel), only ever
+increase and wrap implicitly, each side only writes its own position.
+Instead of stretching the number of samples per frame, the consumer keeps the
+buffered amount around the target latency by adjusting the emulation speed
+via core_sound_throttle_adj_target().
+*/
+
+#if defined(_MSC_VER)
+ #define RING_LOAD_ACQUIRE(p)      ((UINT32)_InterlockedCompareExchange((volatile long*)(p), 0, 0))
+ #define RING_STORE_RELEASE(p, v)  _InterlockedExchange((volatile long*)(p), (long)(v))
+#else
+ #define RING_LOAD_ACQUIRE(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+ #define RING_STORE_RELEASE(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#endif
 
-static INT16* streamingBuf = NULL;
-static int streamingBufferInitialized = 0;
-static int writingToStreamDiff = 0;
+static INT16* ringBuf = NULL;
+static UINT32 ringFrames;  // power of 2
+static volatile UINT32 ringWritePos;
+static volatile UINT32 ringReadPos;
+static int ringPrimed;     // consumer side only: output starts once the target latency is buffered
 
 int osd_start_audio_stream(int stereo)
 {
+	UINT32 minFrames;
+
 	printf("osd_start_audio_stream SampleRate:%.2f stereo:%d fps:%.2f\n", Machine->sample_rate,stereo, Machine->drv->frames_per_second);
 	channels = stereo ? 2 : 1;
 
-	// compute the buffer sizes
-	stream_buffer_size = ((UINT64)MAX_BUFFER_SIZE * (UINT64)(Machine->sample_rate+0.5)) / 44100; //!! 44100 ?!
-	stream_buffer_size = (int)((double)(stream_buffer_size * 30) / Machine->drv->frames_per_second + 0.5);
-	stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-	stream_buffer_size *= channels;
-	// compute the upper/lower thresholds
-	lower_thresh = audio_latency * stream_buffer_size / 5;
-	upper_thresh = (audio_latency + 1) * stream_buffer_size / 5;
+	// compute the buffer size
+	minFrames = (UINT32)(Machine->sample_rate * MAX(audio_latency * RING_LATENCY_FACTOR, RING_MIN_MSECS) / 1000);
+	for (ringFrames = 1024; ringFrames < minFrames; ringFrames <<= 1)
+		;
 
-	streamingBuf = (INT16*)malloc(stream_buffer_size * sizeof(INT16));
-	streamingBufferInitialized = 1;
-	currentStreamingBufferPos = 0;
-	currentWritingBufferPos = 0;
+	ringBuf = (INT16*)malloc(ringFrames * channels * sizeof(INT16));
+	ringWritePos = 0;
+	ringReadPos = 0;
+	ringPrimed = 0;
 
 	// determine the number of samples per frame
 	samples_per_frame = Machine->sample_rate / Machine->drv->frames_per_second;
@@ -123,162 +140,111 @@ int osd_start_audio_stream(int stereo)
 	samples_this_frame = (UINT32)samples_left_over;
 	samples_left_over -= (double)samples_this_frame;
 
-	writing_advance = (int)(samples_per_frame * channels * 3);
-
-	printf("stream_buffer_size: %d lower_thresh:%d upper_thresh: %d\n", stream_buffer_size, lower_thresh, upper_thresh);
+	printf("ring buffer: %u frames, target latency: %d msecs\n", ringFrames, audio_latency);
 
 	// return the samples to play the first frame
 	return samples_this_frame;
 }
 
-//static cycles_t lastUpdate = 0;
-//static int tmp = 0;
-
 int osd_update_audio_stream(INT16 *buf)
 {
-	unsigned int i;
-
-	if (!streamingBufferInitialized)
-		return samples_this_frame;
-	//cycles_t cyc = osd_cycles();
-	//printf("Updt: %d\n", (cyc - lastUpdate));
-	//lastUpdate = cyc;
-
-	//printf("samples_this_frame: %d\n", samples_this_frame);
-
-	for (i = 0; i < samples_this_frame*channels; i++)
+	if (ringBuf)
 	{
-		streamingBuf[currentWritingBufferPos] = buf[i];
-		currentWritingBufferPos++;
-		if (currentWritingBufferPos >= stream_buffer_size)
-			currentWritingBufferPos = 0;
-		writingToStreamDiff++;
-	}
+		const UINT32 writePos = ringWritePos;
+		const UINT32 space = ringFrames - (writePos - RING_LOAD_ACQUIRE(&ringReadPos));
+		// on overrun (host isn't fetching) drop the newest samples, the consumer resyncs anyway
+		const UINT32 frames = MIN(samples_this_frame, space);
+		const UINT32 ofs = writePos & (ringFrames - 1);
+		const UINT32 first = MIN(frames, ringFrames - ofs);
 
-	// Adjustment
-	{
-		int potentialDiff = writingToStreamDiff - writing_advance;
-		
-		//Try to let approx one frame of advance to writing
-		if (potentialDiff != 0)
-			current_adjustment = potentialDiff > 0 ? -1 : 1;
-
-		//if ((++tmp) % 30 == 0)
-		//	printf("potentialDiff: %d current_adjustment: %d samples_this_frame %d\n", potentialDiff, current_adjustment, samples_this_frame);
-	}
+		memcpy(ringBuf + ofs * channels, buf, first * channels * sizeof(INT16));
+		memcpy(ringBuf, buf + first * channels, (frames - first) * channels * sizeof(INT16));
 
-	//if ((++tmp)  % 30 == 0)
-	//	printf("writingToStreamDif: %d current_adjustment: %d samples_this_frame %d\n", writingToStreamDiff, current_adjustment, samples_this_frame);
+		RING_STORE_RELEASE(&ringWritePos, writePos + frames);
+	}
 
 	// compute how many samples to generate next frame
 	samples_left_over += samples_per_frame;
 	samples_this_frame = (UINT32)samples_left_over;
 	samples_left_over -= (double)samples_this_frame;
 
-	samples_this_frame += current_adjustment;
-
-	//if (streamingBufSize >= 0)
-	//	samples_this_frame = streamingBufSize;
-
 	// return the samples to play this next frame
 	return samples_this_frame;
 }
 
 void osd_stop_audio_stream(void)
 {
-	if(streamingBuf)
-		free(streamingBuf);
-	streamingBuf = NULL;
-	streamingBufferInitialized = 0;
-	writingToStreamDiff = 0;
-	currentWritingBufferPos = 0;
-	currentStreamingBufferPos = -1; // -1 means not ready
-	streamingBufSize = -1; // Hold the data to be out using get pending
-	current_adjustment = 0;
-	writing_advance = 0;
-}
-
-void forceResync()
-{
-	currentStreamingBufferPos = (int)((long)(currentWritingBufferPos - writing_advance) % (long)stream_buffer_size);
-	printf("Resync %d (dropped:%d samples)\n", writingToStreamDiff, (writingToStreamDiff - writing_advance));
-	writingToStreamDiff = writing_advance;
+	if(ringBuf)
+		free(ringBuf);
+	ringBuf = NULL;
+	ringWritePos = 0;
+	ringReadPos = 0;
+	ringPrimed = 0;
 }
 
-//static cycles_t last = 0;
-
 int fillAudioBuffer(void *const dest, const int outChannels, const int maxSamples, const int is_float)
 {
-	int nbOut = streamingBufSize;
+	UINT32 writePos, readPos, avail, frames, i;
+	int sIn, sOut;
 
-	if (g_fPause)
+	if (g_fPause || !ringBuf)
 		return 0;
 
-	if (!streamingBufferInitialized)
-		return 0;
+	writePos = RING_LOAD_ACQUIRE(&ringWritePos);
+	readPos = ringReadPos;
+	avail = writePos - readPos;
 
-	if (streamingBufSize < 0)
+	// (re)start only once enough is buffered, so we don't immediately underrun again
+	if (!ringPrimed)
 	{
-		streamingBufSize = maxSamples;
-		forceResync();
-		return 0;
+		if (avail < (UINT32)(Machine->sample_rate * audio_latency / 1000))
+			return 0;
+		ringPrimed = 1;
 	}
-	//cycles_t cyc = osd_cycles();
-	//printf("Fill: %d\n",(cyc-last));
-	//last = cyc;
 
-	if (nbOut > maxSamples)
-		nbOut = maxSamples;
-
-	if (channels == outChannels) // stereo to stereo or mono to mono
+	frames = MIN((UINT32)(maxSamples / outChannels), avail);
+	for (i = 0; i < frames; i++)
 	{
-		int i;
-		for (i = 0; i < nbOut; i++)
+		const INT16* const in = ringBuf + ((readPos + i) & (ringFrames - 1)) * channels;
+		INT16 l, r;
+		if (channels == 2)
+			{ l = in[0]; r = in[1]; }
+		else
+			l = r = in[0];
+
+		if (outChannels == 2)
 		{
 			if (is_float)
-				((float*)dest)[i] = (float)streamingBuf[currentStreamingBufferPos] * (float)(1./32768.0);
+				{ ((float*)dest)[i*2] = (float)l * (float)(1./32768.0); ((float*)dest)[i*2+1] = (float)r * (float)(1./32768.0); }
 			else
-				((INT16*)dest)[i] = streamingBuf[currentStreamingBufferPos];
-			currentStreamingBufferPos++;
-			if (currentStreamingBufferPos >= stream_buffer_size)
-				currentStreamingBufferPos = 0;
-			//writingToStreamDiff--;
+				{ ((INT16*)dest)[i*2] = l; ((INT16*)dest)[i*2+1] = r; }
 		}
-		writingToStreamDiff -= nbOut;
-	}
-	else
-	if(channels == 1 && outChannels == 2) // Mono to stereo
-	{
-		const int nbToRead = nbOut / 2;
-		int outPos = 0;
-		int i;
-		assert((nbOut % 2) == 0);
-		for (i = 0; i < nbToRead; i++)
+		else
 		{
-			// Copy the mono on both out left and right
+			// stereo to mono (or mono to mono, where l == r)
+			const int m = ((int)l + (int)r) / 2;
 			if (is_float)
-				((float*)dest)[outPos] = ((float*)dest)[outPos+1] = (float)streamingBuf[currentStreamingBufferPos] * (float)(1./32768.0);
+				((float*)dest)[i] = (float)m * (float)(1./32768.0);
 			else
-				((INT16*)dest)[outPos] = ((INT16*)dest)[outPos+1] = streamingBuf[currentStreamingBufferPos];
-			outPos += 2;
-			currentStreamingBufferPos++;
-			if (currentStreamingBufferPos >= stream_buffer_size)
-				currentStreamingBufferPos = 0;
-			//writingToStreamDiff--;
+				((INT16*)dest)[i] = (INT16)m;
 		}
-		writingToStreamDiff -= nbToRead;
-	}
-	else
-	if(channels == 2 && outChannels == 1) // Stereo to mono
-	{
-		assert(0);
-		//!! TODO
 	}
+	readPos += frames;
+
+	if (frames < (UINT32)(maxSamples / outChannels))
+		ringPrimed = 0; // underrun
+
+	// keep the buffered amount around the target latency, this may also drop samples.
+	// Pass the real amount (relative to readPos) instead of the positions modulo ringFrames,
+	// which would turn a completely full ring into an empty one.
+	sIn = (int)(writePos - readPos);
+	sOut = 0;
+	core_sound_throttle_adj_target(sIn, &sOut, (int)ringFrames, Machine->sample_rate, audio_latency);
+	readPos += (UINT32)sOut;
 
-	if (writingToStreamDiff > writing_advance*2 || writingToStreamDiff < 0)
-		forceResync();
+	RING_STORE_RELEASE(&ringReadPos, readPos);
 
-	return nbOut;
+	return frames * outChannels;
 }
 
 /*
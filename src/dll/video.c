@@ -399,11 +399,14 @@ static void throttle_speed(void) {
 	cps = osd_cycles_per_second();
 	target = this_frame_base + (int)((double)frameskip_counter * (double)cps / video_fps);
 
-	if (curr - target < 0) {
-		if (ticks_per_sleep_msec == 0) {
-			ticks_per_sleep_msec = (double)(cps / 1000);
-	}
+	if (ticks_per_sleep_msec == 0)
+		ticks_per_sleep_msec = (double)(cps / 1000);
+
+	// Adjust target for sound catchup
+	if (g_iThrottleAdj)
+		target -= (cycles_t)(g_iThrottleAdj*ticks_per_sleep_msec);
 
+	if (curr - target < 0) {
 		while (curr - target < 0) {
 			if (allow_sleep && (!autoframeskip || frameskip == 0) &&
 				(target - curr) > (cycles_t)(ticks_per_sleep_msec * 1.1)) {
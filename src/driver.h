@@ -91,6 +91,8 @@ typedef struct {
   int dmd_red0, dmd_green0, dmd_blue0;
   int dmd_opacity;
   int resampling_quality;
+  int dcs_cache;
+  int idle_skip;
 #if defined(VPINMAME_ALTSOUND) || defined(VPINMAME_PINSOUND)
   int sound_mode; // 0 = pinmame, 1 = altsound, 2 = pinsound, 3 = pinsound + recordings
 #endif
@@ -518,6 +520,7 @@ struct GameDriver
 #define GAME_NO_COCKTAIL                        0x0100  /* screen flip support is missing */
 #define GAME_NO_SOUND                           0x0200  /* sound is missing */
 #define GAME_IMPERFECT_SOUND            0x0400  /* sound is known to be wrong */
+#define GAME_SUPPORTS_SAVE              0x1000  /* game registers its complete state, needed for the in-memory snapshots */
 #define NOT_A_DRIVER                            0x4000  /* set by the fake "root" driver_0 and by "containers" */
                                                                                         /* e.g. driver_neogeo. */
 #ifdef MESS
@@ -59,6 +59,10 @@
 static mame_file *generic_fopen(int pathtype, const char *gamename, const char *filename, const char* hash, UINT32 flags);
 static const char *get_extension_for_filetype(int filetype);
 static int checksum_file(int pathtype, int pathindex, const char *file, UINT8 **p, UINT64 *size, char* hash);
+#ifdef PINMAME
+static int romcache_read(UINT32 crc, UINT32 length, unsigned int functions, mame_file *file);
+static void romcache_write(UINT32 crc, const mame_file *file);
+#endif /* PINMAME */
 
 
 /***************************************************************************
@@ -950,6 +954,32 @@ static mame_file *generic_fopen(int pathtype, const char *gamename, const char *
 				else
 				{
 					int err;
+#ifdef PINMAME
+					UINT32 zipcrc = 0;
+
+					/* The central directory gives the CRC and length without inflating anything;
+					   an unchanged file is then loaded from the ROM cache, hash included */
+					if (options.rom_cache && pathtype == FILETYPE_ROM)
+					{
+						UINT8 crcs[4];
+						unsigned functions = hash_data_used_functions(hash);
+						if (options.crc_only && (functions & HASH_CRC))
+							functions = HASH_CRC;
+						else if (functions == 0)
+							functions = (1 << HASH_NUM_FUNCTIONS) - 1;
+
+						if (hash && hash_data_extract_binary_checksum(hash, HASH_CRC, crcs) != 0)
+							zipcrc = ((UINT32)crcs[0] << 24) | ((UINT32)crcs[1] << 16) | ((UINT32)crcs[2] << 8) | (UINT32)crcs[3];
+						if (checksum_zipped_file(pathtype, pathindex, name, tempname, &ziplength, &zipcrc) != 0)
+							zipcrc = 0;
+						else if (romcache_read(zipcrc, ziplength, functions, &file) == 0)
+						{
+							LOG(("Using (mame_fopen) ROM cache for %s\n", filename));
+							file.type = ZIPPED_FILE;
+							break;
+						}
+					}
+#endif /* PINMAME */
 
 					/* Try loading the file */
 					err = load_zipped_file(pathtype, pathindex, name, tempname, &file.data, &ziplength);
@@ -984,6 +1014,10 @@ static mame_file *generic_fopen(int pathtype, const char *gamename, const char *
 							functions = HASH_CRC;
 
 						hash_compute(file.hash, file.data, file.length, functions);
+#ifdef PINMAME
+						if (zipcrc)
+							romcache_write(zipcrc, &file);
+#endif /* PINMAME */
 						break;
 					}
 				}
@@ -1082,6 +1116,109 @@ static int checksum_file(int pathtype, int pathindex, const char *file, UINT8 **
 	osd_fclose(f);
 	return 0;
 }
+
+
+
+#ifdef PINMAME
+/***************************************************************************
+	ROM cache
+
+	Holds the inflated contents of zipped ROM files, so that unchanged sets
+	(e.g. the 32-128MB SAM ones) load without inflating and hashing every
+	byte again. Each file is named after the CRC and length of the zip
+	member (as found in the zip directory) and starts with a small header
+	that also holds the hash computed when it was written.
+***************************************************************************/
+
+#define ROMCACHE_MAGIC			"PMROMC1"
+#define ROMCACHE_HEADER_SIZE	(8 + 4 + 4 + HASH_BUF_SIZE)
+
+INLINE void romcache_name(char *name, UINT32 crc, UINT32 length)
+{
+	sprintf(name, "%08x-%08x.bin", crc, length);
+}
+
+static int romcache_read(UINT32 crc, UINT32 length, unsigned int functions, mame_file *file)
+{
+	UINT8 header[ROMCACHE_HEADER_SIZE];
+	const char *cachedhash = (const char *)&header[16];
+	char name[32];
+	osd_file *f;
+	UINT8 *data;
+	int i;
+
+	if (osd_get_path_count(FILETYPE_ROMCACHE) == 0)
+		return -1;
+	romcache_name(name, crc, length);
+	f = osd_fopen(FILETYPE_ROMCACHE, 0, name, "rb");
+	if (!f)
+		return -1;
+
+	/* the header has to match the zip member, and hold all the checksums we need */
+	if (osd_fread(f, header, ROMCACHE_HEADER_SIZE) != ROMCACHE_HEADER_SIZE
+		|| memcmp(header, ROMCACHE_MAGIC, 8) != 0
+		|| memcmp(&header[8], &crc, 4) != 0 || memcmp(&header[12], &length, 4) != 0
+		|| (hash_data_used_functions(cachedhash) & functions) != functions)
+	{
+		osd_fclose(f);
+		return -1;
+	}
+
+	data = malloc(length ? length : 1);
+	if (!data || osd_fread(f, data, length) != length)
+	{
+		free(data);
+		osd_fclose(f);
+		return -1;
+	}
+	osd_fclose(f);
+
+	/* only hand out the checksums a fresh load would have computed */
+	hash_data_clear(file->hash);
+	for (i = 1; i != (1 << HASH_NUM_FUNCTIONS); i <<= 1)
+		if (functions & i)
+		{
+			UINT8 checksum[20];
+			if (hash_data_extract_binary_checksum(cachedhash, i, checksum))
+				hash_data_insert_binary_checksum(file->hash, i, checksum);
+		}
+
+	file->data = data;
+	file->length = length;
+	return 0;
+}
+
+static void romcache_write(UINT32 crc, const mame_file *file)
+{
+	UINT8 header[ROMCACHE_HEADER_SIZE];
+	const UINT32 length = (UINT32)file->length;
+	char name[32];
+	osd_file *f;
+
+	if (osd_get_path_count(FILETYPE_ROMCACHE) == 0)
+		return;
+	romcache_name(name, crc, length);
+	f = osd_fopen(FILETYPE_ROMCACHE, 0, name, "wb");
+	if (!f)
+		return;
+
+	memcpy(header, ROMCACHE_MAGIC, 8);
+	memcpy(&header[8], &crc, 4);
+	memcpy(&header[12], &length, 4);
+	memcpy(&header[16], file->hash, HASH_BUF_SIZE);
+	if (osd_fwrite(f, header, ROMCACHE_HEADER_SIZE) != ROMCACHE_HEADER_SIZE
+		|| osd_fwrite(f, file->data, length) != length)
+	{
+		/* leave no truncated entry behind, the next load will try again */
+		osd_fseek(f, 0, SEEK_SET);
+		osd_fwrite(f, "\0", 1);
+	}
+	osd_fclose(f);
+}
+#endif /* PINMAME */
+
+
+
 /***************************************************************************
 	mame_fputs
 ***************************************************************************/
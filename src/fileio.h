@@ -30,6 +30,7 @@ enum
 	FILETYPE_IMAGE_DIFF,
 #ifdef PINMAME
 	FILETYPE_WAVE,
+	FILETYPE_ROMCACHE,
 #ifdef PROC_SUPPORT
 	FILETYPE_PROC,	/* for path */
 	FILETYPE_PROC_YAML,
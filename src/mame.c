@@ -1348,9 +1348,12 @@ int updatescreen(void)
 	/* if we're not skipping this frame, draw the screen */
 	if (osd_skip_this_frame() == 0)
 	{
+		cycles_t start = perfcount_active ? osd_cycles() : 0;
 		profiler_mark(PROFILER_VIDEO);
 		draw_screen();
 		profiler_mark(PROFILER_END);
+		if (perfcount_active)
+			perfcount_add(PERFCOUNT_VIDEO, -1, NULL, 0, start);
 	}
 
 	/* the user interface must be called between vh_update() and osd_update_video_and_audio(), */
@@ -227,6 +227,7 @@ struct GameOptions
 
 	char	savegame;		/* character representing a savegame to load */
 	int     crc_only;       /* specify if only CRC should be used as checksum */
+	int     rom_cache;      /* keep the inflated contents of zipped ROMs in the ROM cache directory */
 	char *	bios;			/* specify system bios (if used), 0 is default */
 
 	int		debug_width;	/* requested width of debugger bitmap */
@@ -236,6 +237,13 @@ struct GameOptions
 	int		at91jit;
 	int		usemodsol; 
 
+	double	snapshot_interval;	/* take an in-memory snapshot every this many seconds (0 = off) */
+	int		snapshot_count;		/* number of in-memory snapshots kept for rewinding */
+	double	boot_snapshot_time;	/* cache the machine state this many seconds after power on and restore it on later starts, GAME_SUPPORTS_SAVE games only (0 = off) */
+	int		perf_counters;		/* enable the performance counters, see profiler.h */
+	char *	perf_trace;			/* write a Chrome/Perfetto trace of the performance counters to this file (NULL = off) */
+	char *	dmd_record;			/* append all DMD sub-frames to this file (NULL = off), see wpc/dmdrec.c */
+
 	#ifdef MESS
 	UINT32 ram;
 	struct ImageFile image_files[MAX_IMAGES];
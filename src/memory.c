@@ -51,6 +51,15 @@
 	(such as RAM, ROM, NOP, and banking). Table values between 32 and 192
 	are assigned dynamically at startup.
 
+	8-bit CPUs with a 16-bit address space additionally get a direct
+	page table per CPU with one entry per 256 bytes. A page whose
+	addresses all map to RAM/ROM or to the same bank is read and written
+	through cpu_bankbase without any lookup or handler call; all other
+	pages (I/O, mixed pages, banks with a replaced handler) have 0 there
+	and fall back to the lookup above. The tables are rebuilt whenever
+	handlers are installed or bank handlers are changed; cpu_setbank
+	needs no rebuild, as the bank base is fetched on every access.
+
 ***************************************************************************/
 
 /* macros for the profiler */
@@ -59,6 +68,30 @@
 #define MEMWRITESTART			profiler_mark(PROFILER_MEMWRITE);
 #define MEMWRITEEND(ret)		{ (ret); profiler_mark(PROFILER_END); return; }
 
+/* handler calls, also counted by the performance counters if enabled */
+#define MEMREADHANDLER(handler,ret)																\
+	{																							\
+		if (perfcount_active)																	\
+		{																						\
+			cycles_t start = osd_cycles();														\
+			UINT32 result = (ret);																\
+			perfcount_add(PERFCOUNT_READ, cur_context, (const void *)handler, 0, start);		\
+			MEMREADEND(result)																	\
+		}																						\
+		MEMREADEND(ret)																			\
+	}
+#define MEMWRITEHANDLER(handler,ret)															\
+	{																							\
+		if (perfcount_active)																	\
+		{																						\
+			cycles_t start = osd_cycles();														\
+			(ret);																				\
+			perfcount_add(PERFCOUNT_WRITE, cur_context, (const void *)handler, 0, start);		\
+			MEMWRITEEND(0)																		\
+		}																						\
+		MEMWRITEEND(ret)																		\
+	}
+
 #define DATABITS_TO_SHIFT(d)	(((d) == 32) ? 2 : ((d) == 16) ? 1 : 0)
 
 /* helper macros */
@@ -126,6 +159,10 @@ struct cpu_data
 
 	struct memport_data	mem;				/* memory tables */
 	struct memport_data	port;				/* port tables */
+
+	UINT8				fastpages;			/* direct page tables valid? */
+	UINT8				fastread[0x100];	/* direct read entry per 256 byte page, 0 = use the lookup */
+	UINT8				fastwrite[0x100];	/* direct write entry per 256 byte page, 0 = use the lookup */
 };
 
 struct memory_address_table
@@ -153,6 +190,11 @@ static UINT8 *				writemem_lookup;				/* memory write lookup table */
 static UINT8 *				readport_lookup;				/* port read lookup table */
 static UINT8 *				writeport_lookup;				/* port write lookup table */
 
+static UINT8 *				readmem_fastpage;				/* memory read direct pages, NULL if none */
+static UINT8 *				writemem_fastpage;				/* memory write direct pages, NULL if none */
+#define readport_fastpage	((UINT8 *)NULL)					/* ports have no direct pages */
+#define writeport_fastpage	((UINT8 *)NULL)
+
 offs_t						mem_amask;						/* memory address mask */
 static offs_t				port_amask;						/* port address mask */
 
@@ -213,6 +255,7 @@ static int allocate_memory(void);
 static int populate_memory(void);
 static int populate_ports(void);
 static void register_banks(void);
+static void update_fastpages(int cpunum);
 static int mem_address_bits_of_cpu(int cpunum);
 static int port_address_bits_of_cpu(int cpunum);
 static int init_static(void);
@@ -232,6 +275,8 @@ static void verify_masks(void);
 
 int memory_init(void)
 {
+	int cpunum;
+
 #ifdef CHECK_MASKS
 	verify_masks();
 #endif
@@ -266,6 +311,10 @@ int memory_init(void)
 
 	register_banks();
 
+	/* build the direct page tables */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+		update_fastpages(cpunum);
+
 #ifdef MEM_DUMP
 	/* dump the final memory configuration */
 	mem_dump();
@@ -298,6 +347,7 @@ void memory_shutdown(void)
 			free(cpudata[cpunum].port.write.table);
 	}
 	memset(&cpudata, 0, sizeof(cpudata));
+	readmem_fastpage = writemem_fastpage = NULL;
 
 	/* free all the external memory */
 	ext = ext_memory;
@@ -366,6 +416,8 @@ void memory_set_context(int activecpu)
 
 	readmem_lookup = cpudata[activecpu].mem.read.table;
 	writemem_lookup = cpudata[activecpu].mem.write.table;
+	readmem_fastpage = cpudata[activecpu].fastpages ? cpudata[activecpu].fastread : NULL;
+	writemem_fastpage = cpudata[activecpu].fastpages ? cpudata[activecpu].fastwrite : NULL;
 	readport_lookup = cpudata[activecpu].port.read.table;
 	writeport_lookup = cpudata[activecpu].port.write.table;
 
@@ -394,6 +446,8 @@ void memory_set_unmap_value(data32_t value)
 
 void memory_set_bankhandler_r(int bank, offs_t offset, mem_read_handler handler)
 {
+	int cpunum;
+
 	/* determine the new offset */
 	if (HANDLER_IS_RAM(handler) || HANDLER_IS_ROM(handler))
 		rmemhandler8[bank].offset = 0 - offset, handler = (mem_read_handler)STATIC_RAM;
@@ -406,6 +460,10 @@ void memory_set_bankhandler_r(int bank, offs_t offset, mem_read_handler handler)
 	if (HANDLER_IS_STATIC(handler))
 		handler = rmemhandler8s[(FPTR)handler];
 	rmemhandler8[bank].handler = (genf *)handler;
+
+	/* the bank may no longer be read directly */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+		update_fastpages(cpunum);
 }
 
 
@@ -416,6 +474,8 @@ void memory_set_bankhandler_r(int bank, offs_t offset, mem_read_handler handler)
 
 void memory_set_bankhandler_w(int bank, offs_t offset, mem_write_handler handler)
 {
+	int cpunum;
+
 	/* determine the new offset */
 	if (HANDLER_IS_RAM(handler) || HANDLER_IS_ROM(handler) || HANDLER_IS_RAMROM(handler))
 		wmemhandler8[bank].offset = 0 - offset;
@@ -428,6 +488,10 @@ void memory_set_bankhandler_w(int bank, offs_t offset, mem_write_handler handler
 	if (HANDLER_IS_STATIC(handler))
 		handler = wmemhandler8s[(FPTR)handler];
 	wmemhandler8[bank].handler = (genf *)handler;
+
+	/* the bank may no longer be written directly */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+		update_fastpages(cpunum);
 }
 
 
@@ -462,6 +526,7 @@ data8_t *install_mem_read_handler(int cpunum, offs_t start, offs_t end, mem_read
 
 	/* install the handler */
 	install_mem_handler(&cpudata[cpunum].mem, 0, start, end, (genf *)handler);
+	update_fastpages(cpunum);
 #ifdef MEM_DUMP
 	/* dump the new memory configuration */
 	mem_dump();
@@ -534,6 +599,7 @@ data8_t *install_mem_write_handler(int cpunum, offs_t start, offs_t end, mem_wri
 
 	/* install the handler */
 	install_mem_handler(&cpudata[cpunum].mem, 1, start, end, (genf *)handler);
+	update_fastpages(cpunum);
 #ifdef MEM_DUMP
 	/* dump the new memory configuration */
 	mem_dump();
@@ -979,6 +1045,80 @@ void populate_table(struct memport_data *memport, int iswrite, offs_t start, off
 }
 
 
+/*-------------------------------------------------
+	update_fastpages - rebuild the direct page
+	tables of an 8-bit CPU with a 16-bit address
+	space; a page gets the entry of its addresses
+	if they all share one that can be accessed
+	without calling a handler (RAM/ROM, or a bank
+	with its default handler), 0 otherwise
+-------------------------------------------------*/
+
+static UINT8 lookup_entry(const struct memport_data *memport, const struct table_data *tabledata, offs_t address)
+{
+	UINT8 entry = tabledata->table[LEVEL1_INDEX(address, memport->abits, 0)];
+	if (entry >= SUBTABLE_BASE)
+		entry = tabledata->table[LEVEL2_INDEX(entry, address, memport->abits, 0)];
+	return entry;
+}
+
+static void update_fastpages(int cpunum)
+{
+	struct cpu_data *data = &cpudata[cpunum];
+	int iswrite;
+
+	if (cpunum < 0 || cpunum >= MAX_CPU || data->mem.dbits != 8 || data->mem.abits != 16 || !data->mem.read.table)
+		return;
+
+	for (iswrite = 0; iswrite < 2; iswrite++)
+	{
+		const struct table_data *tabledata = iswrite ? &data->mem.write : &data->mem.read;
+		UINT8 *pages = iswrite ? data->fastwrite : data->fastread;
+		offs_t page, address;
+
+		for (page = 0; page < 0x100; page++)
+		{
+			UINT8 entry = lookup_entry(&data->mem, tabledata, page << 8);
+
+			if (entry != STATIC_RAM)
+			{
+				if (!HANDLER_IS_BANK(entry))
+					entry = 0;
+				else if (iswrite && wmemhandler8[entry].handler != (genf *)wmemhandler8s[entry])
+					entry = 0;
+				else if (!iswrite && rmemhandler8[entry].handler != (genf *)rmemhandler8s[entry])
+					entry = 0;
+			}
+			for (address = (page << 8) + 1; entry && address < ((page + 1) << 8); address++)
+				if (lookup_entry(&data->mem, tabledata, address) != entry)
+					entry = 0;
+			pages[page] = entry;
+		}
+	}
+	data->fastpages = 1;
+
+	if (cpunum == cur_context)
+	{
+		readmem_fastpage = data->fastread;
+		writemem_fastpage = data->fastwrite;
+	}
+}
+
+
+/*-------------------------------------------------
+	memory_is_direct_read - true if the active CPU
+	reads the address without calling a handler,
+	i.e. it only changes by memory writes or bank
+	switches; only known for CPUs with direct page
+	tables, false for all others
+-------------------------------------------------*/
+
+int memory_is_direct_read(offs_t address)
+{
+	return readmem_fastpage != NULL && readmem_fastpage[(address >> 8) & 0xff] != 0;
+}
+
+
 /*-------------------------------------------------
 	assign_dynamic_bank - finds a free or exact
 	matching bank
@@ -1819,7 +1959,7 @@ extern void bpr_memref(UINT32 adr, int length);
 #define bpr_memref(a,l)
 #endif
 
-#define READBYTE8(name,abits,lookup,handlist,mask)										\
+#define READBYTE8(name,abits,lookup,fastpage,handlist,mask)								\
 data8_t name(offs_t address)															\
 {																						\
 	UINT8 entry;																		\
@@ -1827,6 +1967,11 @@ data8_t name(offs_t address)															\
 																						\
 	/* perform lookup */																\
 	address &= mask;bpr_memref(address,1);																	\
+																						\
+	/* direct RAM/ROM/bank pages, see update_fastpages */								\
+	if (abits == 16 && fastpage != NULL && (entry = fastpage[address >> 8]) != 0)		\
+		MEMREADEND(cpu_bankbase[entry][address - handlist[entry].offset])				\
+																						\
 	entry = lookup[LEVEL1_INDEX(address,abits,0)];										\
 	if (entry >= SUBTABLE_BASE)															\
 		entry = lookup[LEVEL2_INDEX(entry,address,abits,0)];							\
@@ -1840,7 +1985,7 @@ data8_t name(offs_t address)															\
 	else																				\
 	{																					\
 		read8_handler handler = (read8_handler)handlist[entry].handler;					\
-		MEMREADEND((*handler)(address - handlist[entry].offset))						\
+		MEMREADHANDLER(handler, (*handler)(address - handlist[entry].offset))						\
 	}																					\
 	return 0;																			\
 }																						\
@@ -1867,7 +2012,7 @@ data8_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (~address & 1);													\
 		read16_handler handler = (read16_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 1, ~(0xff << shift)) >> shift)					\
+		MEMREADHANDLER(handler, (*handler)(address >> 1, ~(0xff << shift)) >> shift)					\
 	}																					\
 	return 0;																			\
 }																						\
@@ -1894,7 +2039,7 @@ data8_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (address & 1);													\
 		read16_handler handler = (read16_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 1, ~(0xff << shift)) >> shift)					\
+		MEMREADHANDLER(handler, (*handler)(address >> 1, ~(0xff << shift)) >> shift)					\
 	}																					\
 	return 0;																			\
 }																						\
@@ -1921,7 +2066,7 @@ data8_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (~address & 3);													\
 		read32_handler handler = (read32_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 2, ~(0xff << shift)) >> shift) 				\
+		MEMREADHANDLER(handler, (*handler)(address >> 2, ~(0xff << shift)) >> shift) 				\
 	}																					\
 	return 0;																			\
 }																						\
@@ -1948,7 +2093,7 @@ data8_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (address & 3);													\
 		read32_handler handler = (read32_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 2, ~(0xff << shift)) >> shift) 				\
+		MEMREADHANDLER(handler, (*handler)(address >> 2, ~(0xff << shift)) >> shift) 				\
 	}																					\
 	return 0;																			\
 }																						\
@@ -1980,7 +2125,7 @@ data16_t name(offs_t address)															\
 	else																				\
 	{																					\
 		read16_handler handler = (read16_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 1,0))										 	\
+		MEMREADHANDLER(handler, (*handler)(address >> 1,0))										 	\
 	}																					\
 	return 0;																			\
 }																						\
@@ -2007,7 +2152,7 @@ data16_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (~address & 2);													\
 		read32_handler handler = (read32_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 2, ~(0xffff << shift)) >> shift)				\
+		MEMREADHANDLER(handler, (*handler)(address >> 2, ~(0xffff << shift)) >> shift)				\
 	}																					\
 	return 0;																			\
 }																						\
@@ -2034,7 +2179,7 @@ data16_t name(offs_t address)															\
 	{																					\
 		int shift = 8 * (address & 2);													\
 		read32_handler handler = (read32_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 2, ~(0xffff << shift)) >> shift)				\
+		MEMREADHANDLER(handler, (*handler)(address >> 2, ~(0xffff << shift)) >> shift)				\
 	}																					\
 	return 0;																			\
 }																						\
@@ -2066,7 +2211,7 @@ data32_t name(offs_t address)															\
 	else																				\
 	{																					\
 		read32_handler handler = (read32_handler)handlist[entry].handler;				\
-		MEMREADEND((*handler)(address >> 2,0))										 	\
+		MEMREADHANDLER(handler, (*handler)(address >> 2,0))										 	\
 	}																					\
 	return 0;																			\
 }																						\
@@ -2076,7 +2221,7 @@ data32_t name(offs_t address)															\
 	WRITEBYTE - generic byte-sized write handler
 -------------------------------------------------*/
 
-#define WRITEBYTE8(name,abits,lookup,handlist,mask)										\
+#define WRITEBYTE8(name,abits,lookup,fastpage,handlist,mask)								\
 void name(offs_t address, data8_t data)													\
 {																						\
 	UINT8 entry;																		\
@@ -2084,6 +2229,11 @@ void name(offs_t address, data8_t data)													\
 																						\
 	/* perform lookup */																\
 	address &= mask;bpr_memref(address,1);																	\
+																						\
+	/* direct RAM/bank pages, see update_fastpages */									\
+	if (abits == 16 && fastpage != NULL && (entry = fastpage[address >> 8]) != 0)		\
+		MEMWRITEEND(cpu_bankbase[entry][address - handlist[entry].offset] = data)		\
+																						\
 	entry = lookup[LEVEL1_INDEX(address,abits,0)];										\
 	if (entry >= SUBTABLE_BASE)															\
 		entry = lookup[LEVEL2_INDEX(entry,address,abits,0)];							\
@@ -2097,7 +2247,7 @@ void name(offs_t address, data8_t data)													\
 	else																				\
 	{																					\
 		write8_handler handler = (write8_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address - handlist[entry].offset, data))					\
+		MEMWRITEHANDLER(handler, (*handler)(address - handlist[entry].offset, data))					\
 	}																					\
 }																						\
 
@@ -2123,7 +2273,7 @@ void name(offs_t address, data8_t data)													\
 	{																					\
 		int shift = 8 * (~address & 1);													\
 		write16_handler handler = (write16_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 1, data << shift, ~(0xff << shift))) 			\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 1, data << shift, ~(0xff << shift))) 			\
 	}																					\
 }																						\
 
@@ -2149,7 +2299,7 @@ void name(offs_t address, data8_t data)													\
 	{																					\
 		int shift = 8 * (address & 1);													\
 		write16_handler handler = (write16_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 1, data << shift, ~(0xff << shift)))			\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 1, data << shift, ~(0xff << shift)))			\
 	}																					\
 }																						\
 
@@ -2175,7 +2325,7 @@ void name(offs_t address, data8_t data)													\
 	{																					\
 		int shift = 8 * (~address & 3);													\
 		write32_handler handler = (write32_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 2, data << shift, ~(0xff << shift))) 			\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 2, data << shift, ~(0xff << shift))) 			\
 	}																					\
 }																						\
 
@@ -2201,7 +2351,7 @@ void name(offs_t address, data8_t data)													\
 	{																					\
 		int shift = 8 * (address & 3);													\
 		write32_handler handler = (write32_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 2, data << shift, ~(0xff << shift))) 			\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 2, data << shift, ~(0xff << shift))) 			\
 	}																					\
 }																						\
 
@@ -2232,7 +2382,7 @@ void name(offs_t address, data16_t data)												\
 	else																				\
 	{																					\
 		write16_handler handler = (write16_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 1, data, 0))								 	\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 1, data, 0))								 	\
 	}																					\
 }																						\
 
@@ -2258,7 +2408,7 @@ void name(offs_t address, data16_t data)												\
 	{																					\
 		int shift = 8 * (~address & 2);													\
 		write32_handler handler = (write32_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 2, data << shift, ~(0xffff << shift))) 		\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 2, data << shift, ~(0xffff << shift))) 		\
 	}																					\
 }																						\
 
@@ -2284,7 +2434,7 @@ void name(offs_t address, data16_t data)												\
 	{																					\
 		int shift = 8 * (address & 2);													\
 		write32_handler handler = (write32_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 2, data << shift, ~(0xffff << shift))) 		\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 2, data << shift, ~(0xffff << shift))) 		\
 	}																					\
 }																						\
 
@@ -2315,7 +2465,7 @@ void name(offs_t address, data32_t data)												\
 	else																				\
 	{																					\
 		write32_handler handler = (write32_handler)handlist[entry].handler;				\
-		MEMWRITEEND((*handler)(address >> 2, data, 0))								 	\
+		MEMWRITEHANDLER(handler, (*handler)(address >> 2, data, 0))								 	\
 	}																					\
 }																						\
 
@@ -2378,8 +2528,8 @@ void name(offs_t pc)																	\
 -------------------------------------------------*/
 
 #define GENERATE_HANDLERS_8BIT(type, abits) \
-	    READBYTE8(cpu_read##type##abits,             abits, read##type##_lookup,  r##type##handler8,  type##_amask) \
-	   WRITEBYTE8(cpu_write##type##abits,            abits, write##type##_lookup, w##type##handler8,  type##_amask)
+	    READBYTE8(cpu_read##type##abits,             abits, read##type##_lookup,  read##type##_fastpage,  r##type##handler8,  type##_amask) \
+	   WRITEBYTE8(cpu_write##type##abits,            abits, write##type##_lookup, write##type##_fastpage, w##type##handler8,  type##_amask)
 
 #define GENERATE_HANDLERS_16BIT_BE(type, abits) \
 	 READBYTE16BE(cpu_read##type##abits##bew,        abits, read##type##_lookup,  r##type##handler16, type##_amask) \
@@ -815,6 +815,7 @@ int			memory_init(void);
 void		memory_shutdown(void);
 void		memory_set_context(int activecpu);
 void		memory_set_unmap_value(data32_t value);
+int			memory_is_direct_read(offs_t address);
 
 /* ----- dynamic bank handlers ----- */
 void		memory_set_bankhandler_r(int bank, offs_t offset, mem_read_handler handler);
@@ -98,6 +98,150 @@ logerror("Profiler error: FILO buffer underflow\n");
 	}
 }
 
+
+
+/*************************************
+ *
+ *	Performance counters
+ *
+ *************************************/
+
+#define PERFCOUNT_MAX		1024		/* power of two */
+
+int perfcount_active;
+
+static struct perfcount_entry perfcount[PERFCOUNT_MAX];
+static UINT16 perfcount_hash[PERFCOUNT_MAX];	/* index+1 into perfcount, 0 = empty */
+static volatile int perfcount_count;
+static volatile int perfcount_reset_pending;
+static cycles_t perfcount_base;
+static FILE *perfcount_trace;
+
+
+void perfcount_init(void)
+{
+	int cpunum;
+
+	perfcount_active = options.perf_counters;
+	perfcount_count = 0;
+	perfcount_reset_pending = 0;
+	memset(perfcount_hash, 0, sizeof(perfcount_hash));
+	perfcount_base = osd_cycles();
+
+	perfcount_trace = NULL;
+	if (!perfcount_active || !options.perf_trace || !options.perf_trace[0])
+		return;
+
+	perfcount_trace = fopen(options.perf_trace, "w");
+	if (!perfcount_trace)
+	{
+		logerror("Could not create the trace file %s\n", options.perf_trace);
+		return;
+	}
+
+	/* one track per CPU, plus one for the timers and one for video/sound */
+	fprintf(perfcount_trace, "{\"traceEvents\":[\n");
+	fprintf(perfcount_trace, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"%s\"}}", Machine->gamedrv->name);
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+		fprintf(perfcount_trace, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"CPU %d %s\"}}",
+			cpunum + 2, cpunum, cputype_name(Machine->drv->cpu[cpunum].cpu_type));
+	fprintf(perfcount_trace, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Timers\"}}");
+	fprintf(perfcount_trace, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Video/Sound\"}}");
+}
+
+
+void perfcount_exit(void)
+{
+	perfcount_active = 0;
+	if (perfcount_trace)
+	{
+		fprintf(perfcount_trace, "\n]}\n");
+		fclose(perfcount_trace);
+		perfcount_trace = NULL;
+	}
+}
+
+
+/* the counters are cleared by the emulation thread on their next update */
+void perfcount_reset(void)
+{
+	perfcount_reset_pending = 1;
+}
+
+
+void perfcount_add(int type, int cpunum, const void *func, UINT32 cycles, cycles_t start)
+{
+	static const char *const names[] = { "CPU", "read", "write", "timer", "video", "sound", "stream", "context", "skipped" };
+	const cycles_t now = osd_cycles();
+	struct perfcount_entry *entry;
+	UINT32 slot = ((UINT32)(FPTR)func >> 2) * 0x9e3779b1 + type * 31 + cpunum;
+
+	if (perfcount_reset_pending)
+	{
+		perfcount_count = 0;
+		memset(perfcount_hash, 0, sizeof(perfcount_hash));
+		perfcount_reset_pending = 0;
+	}
+
+	/* find the counter, or start a new one */
+	for (slot &= PERFCOUNT_MAX - 1; perfcount_hash[slot]; slot = (slot + 1) & (PERFCOUNT_MAX - 1))
+	{
+		entry = &perfcount[perfcount_hash[slot] - 1];
+		if (entry->func == func && entry->type == type && entry->cpunum == cpunum)
+			break;
+	}
+	if (!perfcount_hash[slot])
+	{
+		if (perfcount_count >= PERFCOUNT_MAX - 1)
+			return;
+		entry = &perfcount[perfcount_count];
+		memset(entry, 0, sizeof(*entry));
+		entry->type = type;
+		entry->cpunum = cpunum;
+		entry->func = func;
+		if (type == PERFCOUNT_CPU || type == PERFCOUNT_CONTEXT || type == PERFCOUNT_SKIPPED)
+			entry->name = cputype_name(Machine->drv->cpu[cpunum].cpu_type);
+		else if (type == PERFCOUNT_STREAM)
+			entry->name = mixer_get_name(cpunum);
+		perfcount_hash[slot] = perfcount_count + 1;
+		perfcount_count++;
+	}
+
+	entry->calls++;
+	entry->cycles += cycles;
+	entry->ticks += now - start;
+
+	if (perfcount_trace && type != PERFCOUNT_READ && type != PERFCOUNT_WRITE && type != PERFCOUNT_CONTEXT && type != PERFCOUNT_SKIPPED)
+	{
+		const double scale = 1000000.0 / (double)osd_cycles_per_second();
+		fprintf(perfcount_trace, ",\n{\"name\":\"%s", names[type]);
+		if (entry->name && type != PERFCOUNT_CPU)
+			fprintf(perfcount_trace, " %s", entry->name);
+		else if (func)
+			fprintf(perfcount_trace, " %p", func);
+		fprintf(perfcount_trace, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+			(type == PERFCOUNT_CPU) ? cpunum + 2 : (type == PERFCOUNT_TIMER) ? 1 : 0,
+			(double)(start - perfcount_base) * scale, (double)(now - start) * scale);
+		if (type == PERFCOUNT_CPU)
+			fprintf(perfcount_trace, ",\"args\":{\"cycles\":%u}", cycles);
+		fprintf(perfcount_trace, "}");
+	}
+}
+
+
+/* copies the counters, may be called from other threads (the values of
+   counters changing while copied can be a little off) */
+int perfcount_get(struct perfcount_entry *entries, int maxcount)
+{
+	const int count = perfcount_count;
+	int i;
+
+	for (i = 0; i < count && i < maxcount; i++)
+		entries[i] = perfcount[i];
+	return count;
+}
+
+
 void profiler_show(struct mame_bitmap *bitmap)
 {
 	int i,j;
@@ -68,4 +68,52 @@ void profiler_start(void);
 void profiler_stop(void);
 void profiler_show(struct mame_bitmap *bitmap);
 
+
+/*
+Performance counters: unlike profiler_mark these are compiled into release
+builds too, and cost a single test while they are off. When enabled with
+options.perf_counters, the time spent (in osd_cycles) and the number of calls
+are counted per CPU timeslice, per memory/port handler, per timer callback,
+per sound stream and for the video and sound updates. Times include nested
+entries, e.g. a CPU includes the handlers it calls. CPU context swaps (the
+register file copies done when a CPU takes over from another one of the same
+core) are counted per incoming CPU. The cycles a suspended CPU skips, e.g.
+while sleeping in an idle loop until the next interrupt, are counted per CPU
+with the number of timeslices skipped as calls. options.perf_trace
+additionally writes all but the much more frequent handler calls, context
+swaps and skipped cycles to a Chrome/Perfetto trace file.
+*/
+
+/* libpinmame.h exports these as PINMAME_PERF_xxx, keep them in sync */
+enum {
+	PERFCOUNT_CPU = 0,		/* CPU timeslices */
+	PERFCOUNT_READ,			/* memory/port read handlers */
+	PERFCOUNT_WRITE,		/* memory/port write handlers */
+	PERFCOUNT_TIMER,		/* timer callbacks */
+	PERFCOUNT_VIDEO,		/* video updates */
+	PERFCOUNT_SOUND,		/* sound updates, including the mixer */
+	PERFCOUNT_STREAM,		/* sound stream updates, i.e. the sound chips */
+	PERFCOUNT_CONTEXT,		/* CPU context swaps */
+	PERFCOUNT_SKIPPED		/* cycles skipped while a CPU was suspended */
+};
+
+struct perfcount_entry
+{
+	int type;				/* PERFCOUNT_xxx */
+	int cpunum;				/* CPU running or calling the handler, mixer channel for streams, -1 if none */
+	const void *func;		/* memory/port handler, timer or stream callback, NULL otherwise */
+	const char *name;		/* CPU type (CPU, context and skipped entries) or stream name, NULL otherwise */
+	UINT64 calls;
+	UINT64 cycles;			/* emulated cycles, CPU and skipped entries only */
+	UINT64 ticks;			/* osd_cycles spent */
+};
+
+extern int perfcount_active;
+
+void perfcount_init(void);
+void perfcount_exit(void);
+void perfcount_reset(void);
+void perfcount_add(int type, int cpunum, const void *func, UINT32 cycles, cycles_t start);
+int perfcount_get(struct perfcount_entry *entries, int maxcount);
+
 #endif	/* PROFILER_H */
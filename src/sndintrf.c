@@ -1366,6 +1366,7 @@ void sound_stop(void)
 void sound_update(void)
 {
 	int totalsound = 0;
+	cycles_t start = perfcount_active ? osd_cycles() : 0;
 
 
 	profiler_mark(PROFILER_SOUND);
@@ -1384,6 +1385,8 @@ void sound_update(void)
 	timer_adjust(sound_update_timer, TIME_NEVER, 0, 0);
 
 	profiler_mark(PROFILER_END);
+	if (perfcount_active)
+		perfcount_add(PERFCOUNT_SOUND, -1, NULL, 0, start);
 }
 
 
@@ -208,6 +208,159 @@ INLINE float triangular(const float r) // from -1..1, c=0 (with random no r=0..1
 }
 #endif
 
+/***************************************************************************
+	Block helpers
+
+	The accumulators are rings, so the loops below split a block at the
+	wrap point and leave two plain loops the compiler can vectorise.
+***************************************************************************/
+
+/* dst[pos...] += src[0..len-1] * scale, returns the new ring position */
+INLINE unsigned mixer_accumulate_float(float* const __restrict dst, unsigned pos, const float* __restrict src, unsigned len, const float scale)
+{
+	while (len)
+	{
+		const unsigned n = MIN(len, ACCUMULATOR_SAMPLES - pos);
+		unsigned i;
+		for (i = 0; i < n; i++)
+			dst[pos + i] += src[i] * scale;
+		src += n;
+		len -= n;
+		pos = (pos + n) & ACCUMULATOR_MASK;
+	}
+	return pos;
+}
+
+INLINE unsigned mixer_accumulate_16(float* const __restrict dst, unsigned pos, const INT16* __restrict src, unsigned len, const float scale)
+{
+	while (len)
+	{
+		const unsigned n = MIN(len, ACCUMULATOR_SAMPLES - pos);
+		unsigned i;
+		for (i = 0; i < n; i++)
+			dst[pos + i] += (float)src[i] * scale;
+		src += n;
+		len -= n;
+		pos = (pos + n) & ACCUMULATOR_MASK;
+	}
+	return pos;
+}
+
+INLINE unsigned mixer_accumulate_8(float* const __restrict dst, unsigned pos, const INT8* __restrict src, unsigned len, const float scale)
+{
+	while (len)
+	{
+		const unsigned n = MIN(len, ACCUMULATOR_SAMPLES - pos);
+		unsigned i;
+		for (i = 0; i < n; i++)
+			dst[pos + i] += (float)src[i] * scale;
+		src += n;
+		len -= n;
+		pos = (pos + n) & ACCUMULATOR_MASK;
+	}
+	return pos;
+}
+
+#if defined(RESAMPLER_SSE_OPT) && defined(MIXER_USE_CLIPPING)
+#define MIXER_OUTPUT_BLOCK 64
+
+/* Convert count accumulated samples to 16 bit with TPDF dither and clear them.
+   The four xorshift generators run side by side in the four lanes, 0 - 1 dither
+   the left and 2 - 3 the right channel, exactly like the scalar code does one
+   sample at a time, so the output is the same bit for bit. The conversion and
+   clipping then run on four samples at a time. */
+static void mixer_output_sse(INT16* __restrict mix, unsigned accum_pos, unsigned count)
+{
+	const __m128i exponent = _mm_set1_epi32(0x3F800000);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(32768.f);
+	const __m128 maxval = _mm_set1_ps(32767.f);
+	const __m128 minval = _mm_set1_ps(-32768.f);
+	__m128i x = _mm_setr_epi32(xorshift_state[0].x, xorshift_state[1].x, xorshift_state[2].x, xorshift_state[3].x);
+	__m128i y = _mm_setr_epi32(xorshift_state[0].y, xorshift_state[1].y, xorshift_state[2].y, xorshift_state[3].y);
+	__m128i z = _mm_setr_epi32(xorshift_state[0].z, xorshift_state[1].z, xorshift_state[2].z, xorshift_state[3].z);
+	__m128i w = _mm_setr_epi32(xorshift_state[0].w, xorshift_state[1].w, xorshift_state[2].w, xorshift_state[3].w);
+	float dither_l[MIXER_OUTPUT_BLOCK], dither_r[MIXER_OUTPUT_BLOCK];
+	UINT32 lanes[4][4];
+	int k;
+
+	while (count)
+	{
+		const unsigned len = MIN(MIN(count, MIXER_OUTPUT_BLOCK), ACCUMULATOR_SAMPLES - accum_pos);
+		float* const __restrict left = left_accum + accum_pos;
+		float* const __restrict right = right_accum + accum_pos;
+		unsigned i;
+
+		for (i = 0; i < len; i++)
+		{
+			const __m128i t = _mm_xor_si128(x, _mm_slli_epi32(x, 11));
+			__m128 r;
+			x = y;
+			y = z;
+			z = w;
+			w = _mm_xor_si128(_mm_xor_si128(w, _mm_srli_epi32(w, 19)), _mm_xor_si128(t, _mm_srli_epi32(t, 8)));
+			r = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(exponent, _mm_srli_epi32(w, 9))), one);
+			r = _mm_sub_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)));
+			dither_l[i] = _mm_cvtss_f32(r);
+			dither_r[i] = _mm_cvtss_f32(_mm_movehl_ps(r, r));
+		}
+
+		if (!is_stereo)
+		{
+			for (i = 0; i + 4 <= len; i += 4)
+			{
+				__m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(left + i), scale), _mm_loadu_ps(dither_l + i));
+				const __m128i vi = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(v, maxval), minval));
+				_mm_storel_epi64((__m128i*)(mix + i), _mm_packs_epi32(vi, vi));
+				_mm_storeu_ps(left + i, _mm_setzero_ps());
+			}
+			for (; i < len; i++)
+			{
+				mix[i] = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(left[i]*32768.f + dither_l[i]), maxval), minval));
+				left[i] = 0;
+			}
+			mix += len;
+		}
+		else
+		{
+			for (i = 0; i + 4 <= len; i += 4)
+			{
+				const __m128 l = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(left + i), scale), _mm_loadu_ps(dither_l + i));
+				const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(right + i), scale), _mm_loadu_ps(dither_r + i));
+				const __m128i li = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(l, maxval), minval));
+				const __m128i ri = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(r, maxval), minval));
+				_mm_storeu_si128((__m128i*)(mix + 2*i), _mm_packs_epi32(_mm_unpacklo_epi32(li, ri), _mm_unpackhi_epi32(li, ri)));
+				_mm_storeu_ps(left + i, _mm_setzero_ps());
+				_mm_storeu_ps(right + i, _mm_setzero_ps());
+			}
+			for (; i < len; i++)
+			{
+				mix[2*i]   = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(left[i]*32768.f + dither_l[i]), maxval), minval));
+				mix[2*i+1] = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(right[i]*32768.f + dither_r[i]), maxval), minval));
+				left[i] = 0;
+				right[i] = 0;
+			}
+			mix += 2*len;
+		}
+
+		count -= len;
+		accum_pos = (accum_pos + len) & ACCUMULATOR_MASK;
+	}
+
+	_mm_storeu_si128((__m128i*)lanes[0], x);
+	_mm_storeu_si128((__m128i*)lanes[1], y);
+	_mm_storeu_si128((__m128i*)lanes[2], z);
+	_mm_storeu_si128((__m128i*)lanes[3], w);
+	for (k = 0; k < 4; k++)
+	{
+		xorshift_state[k].x = lanes[0][k];
+		xorshift_state[k].y = lanes[1][k];
+		xorshift_state[k].z = lanes[2][k];
+		xorshift_state[k].w = lanes[3][k];
+	}
+}
+#endif
+
 //!! for audio: maybe we could also simply use bit reversal (or another halton dim) to have kinda high frequency noise? (similar to noise shaping) 
 //   -> exactly other way round as GFX (where low freq is best)! ear NOT sensitive to high frequencies that much!
 //   -> but then also use triangular() instead of rand()-rand()!
@@ -280,25 +433,13 @@ static unsigned mixer_channel_resample_16(struct mixer_channel_data* channel, SR
 		const unsigned len = (src_len > dst_len) ? dst_len : src_len;
 		if (channel->is_float)
 		{
-		const float* const __restrict src_end = srcf + len;
-		while (srcf != src_end)
-		{
-			dst[dst_pos] += *srcf * scale_copy;
-			dst_pos = (dst_pos + 1) & ACCUMULATOR_MASK;
-			++srcf;
-		}
-		*psrc = (INT16*)srcf;
+			dst_pos = mixer_accumulate_float(dst, dst_pos, srcf, len, scale_copy);
+			*psrc = (INT16*)(srcf + len);
 		}
 		else
 		{
-		const INT16* const __restrict src_end = src + len;
-		while (src != src_end)
-		{
-			dst[dst_pos] += (float)*src * scale_copy;
-			dst_pos = (dst_pos + 1) & ACCUMULATOR_MASK;
-			++src;
-		}
-		*psrc = src;
+			dst_pos = mixer_accumulate_16(dst, dst_pos, src, len, scale_copy);
+			*psrc = src + len;
 		}
 
 		return (dst_pos - dst_base) & ACCUMULATOR_MASK;
@@ -414,11 +555,7 @@ static unsigned mixer_channel_resample_16(struct mixer_channel_data* channel, SR
 
 	mixer_apply_reverb_filter(channel, out_f, data.output_frames_gen, left_right);
 
-	for (i = 0; i < data.output_frames_gen; ++i)
-	{
-		dst[dst_pos] += out_f[i] * volume;
-		dst_pos = (dst_pos + 1) & ACCUMULATOR_MASK;
-	}
+	dst_pos = mixer_accumulate_float(dst, dst_pos, out_f, data.output_frames_gen, volume);
 
 	*psrc = channel->is_float ? (INT16*)(srcf+data.input_frames_used) : (src+data.input_frames_used);
 	return (dst_pos - dst_base) & ACCUMULATOR_MASK;
@@ -432,7 +569,6 @@ static unsigned mixer_channel_resample_8(struct mixer_channel_data *channel, SRC
 	const INT8* __restrict src = *psrc;
 
 	SRC_DATA data;
-	long i;
 	const float scale_copy = (float)(volume / 0x80);
 
 	//limit src_len input length, roughly same as old code did basically:
@@ -451,15 +587,9 @@ static unsigned mixer_channel_resample_8(struct mixer_channel_data *channel, SRC
 	{
 		/* copy */
 		const unsigned len = (src_len > dst_len) ? dst_len : src_len;
-		const INT8* const __restrict src_end = src + len;
-		while (src != src_end)
-		{
-			dst[dst_pos] += (float)*src * scale_copy;
-			dst_pos = (dst_pos + 1) & ACCUMULATOR_MASK;
-			++src;
-		}
+		dst_pos = mixer_accumulate_8(dst, dst_pos, src, len, scale_copy);
 
-		*psrc = src;
+		*psrc = src + len;
 		return (dst_pos - dst_base) & ACCUMULATOR_MASK;
 	}
 
@@ -519,11 +649,7 @@ static unsigned mixer_channel_resample_8(struct mixer_channel_data *channel, SRC
 
 	mixer_apply_reverb_filter(channel, out_f, data.output_frames_gen, left_right);
 
-	for (i = 0; i < data.output_frames_gen; ++i)
-	{
-		dst[dst_pos] += out_f[i] * volume;
-		dst_pos = (dst_pos + 1) & ACCUMULATOR_MASK;
-	}
+	dst_pos = mixer_accumulate_float(dst, dst_pos, out_f, data.output_frames_gen, volume);
 
 	*psrc = src + data.input_frames_used;
 	return (dst_pos - dst_base) & ACCUMULATOR_MASK;
@@ -845,6 +971,11 @@ void mixer_sh_update()
 			channel->samples_available -= samples_this_frame;
 	}
 
+#if defined(RESAMPLER_SSE_OPT) && defined(MIXER_USE_CLIPPING)
+	/* dither, clip and copy the 32-bit data to a 16-bit buffer */
+	mixer_output_sse(mix_buffer, accum_pos, samples_this_frame);
+	accum_pos = (accum_pos + samples_this_frame) & ACCUMULATOR_MASK;
+#else
 	/* copy the mono 32-bit data to a 16-bit buffer, clipping along the way */
 	if (!is_stereo)
 	{
@@ -855,9 +986,6 @@ void mixer_sh_update()
 
 			/* fetch and clip the sample */
 			INT16 samplei;
-#if defined(RESAMPLER_SSE_OPT) && defined(MIXER_USE_CLIPPING)
-			samplei = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(left_accum[accum_pos]*32768.f + dither), _mm_set_ss(32767.f)), _mm_set_ss(-32768.f)));
-#else
 			const float sample = left_accum[accum_pos]*32768.f + dither;
 #ifdef MIXER_USE_CLIPPING
 			if (sample <= -32768.f)
@@ -867,7 +995,6 @@ void mixer_sh_update()
 			else
 #endif
 			samplei = (INT16)(lrintf(sample));
-#endif
 			/* store and zero out behind us */
 			*mix++ = samplei;
 			left_accum[accum_pos] = 0;
@@ -887,9 +1014,6 @@ void mixer_sh_update()
 
 			/* fetch and clip the left sample */
 			INT16 samplei;
-#if defined(RESAMPLER_SSE_OPT) && defined(MIXER_USE_CLIPPING)
-			samplei = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(left_accum[accum_pos]*32768.f + dither), _mm_set_ss(32767.f)), _mm_set_ss(-32768.f)));
-#else
 			float sample = left_accum[accum_pos]*32768.f + dither;
 #ifdef MIXER_USE_CLIPPING
 			if (sample <= -32768.f)
@@ -899,7 +1023,6 @@ void mixer_sh_update()
 			else
 #endif
 			samplei = (INT16)(lrintf(sample));
-#endif
 			/* store and zero out behind us */
 			*mix++ = samplei;
 			left_accum[accum_pos] = 0;
@@ -907,9 +1030,6 @@ void mixer_sh_update()
 			dither = xorshift(&xorshift_state[2]) - xorshift(&xorshift_state[3]); // add TPDF dither
 
 			/* fetch and clip the right sample */
-#if defined(RESAMPLER_SSE_OPT) && defined(MIXER_USE_CLIPPING)
-			samplei = (INT16)_mm_cvtss_si32(_mm_max_ss(_mm_min_ss(_mm_set_ss(right_accum[accum_pos]*32768.f + dither), _mm_set_ss(32767.f)), _mm_set_ss(-32768.f)));
-#else
 			sample = right_accum[accum_pos]*32768.f + dither;
 #ifdef MIXER_USE_CLIPPING
 			if (sample <= -32768.f)
@@ -919,7 +1039,6 @@ void mixer_sh_update()
 			else
 #endif
 			samplei = (INT16)(lrintf(sample));
-#endif
 			/* store and zero out behind us */
 			*mix++ = samplei;
 			right_accum[accum_pos] = 0;
@@ -928,6 +1047,7 @@ void mixer_sh_update()
 			accum_pos = (accum_pos + 1) & ACCUMULATOR_MASK;
 		}
 	}
+#endif
 
 	/* play the result */
     {
@@ -50,6 +50,32 @@ void streams_sh_stop(void)
 }
 
 
+/* stream callbacks, also counted by the performance counters if enabled */
+INLINE void call_stream_callback(int channel,void *buf,int length)
+{
+	if (perfcount_active)
+	{
+		cycles_t start = osd_cycles();
+		(*stream_callback[channel])(stream_param[channel],(INT16 *)buf,length);
+		perfcount_add(PERFCOUNT_STREAM, channel, (const void *)stream_callback[channel], 0, start);
+	}
+	else
+		(*stream_callback[channel])(stream_param[channel],(INT16 *)buf,length);
+}
+
+INLINE void call_stream_callback_multi(int channel,const void **buf,int length)
+{
+	if (perfcount_active)
+	{
+		cycles_t start = osd_cycles();
+		(*stream_callback_multi[channel])(stream_param[channel],(INT16 **)buf,length);
+		perfcount_add(PERFCOUNT_STREAM, channel, (const void *)stream_callback_multi[channel], 0, start);
+	}
+	else
+		(*stream_callback_multi[channel])(stream_param[channel],(INT16 **)buf,length);
+}
+
+
 void streams_sh_update(void)
 {
 	int channel;
@@ -83,7 +109,7 @@ void streams_sh_update(void)
 						buf[i] = (UINT8*)(stream_buffer[channel+i]) + stream_buffer_pos[channel+i]*(stream_is_float[channel+i] ? sizeof(float) : sizeof(INT16));
 					}
 
-					(*stream_callback_multi[channel])(stream_param[channel],buf,buflen);
+					call_stream_callback_multi(channel,buf,buflen);
 				}
 
 				for (i = 0;i < stream_joined_channels[channel];i++)
@@ -95,7 +121,7 @@ void streams_sh_update(void)
 				{
 					void *buf = (UINT8*)(stream_buffer[channel]) + stream_buffer_pos[channel] * (stream_is_float[channel] ? sizeof(float) : sizeof(INT16));
 
-					(*stream_callback[channel])(stream_param[channel],buf,buflen);
+					call_stream_callback(channel,buf,buflen);
 				}
 
 				stream_buffer_pos[channel] = 0;
@@ -247,7 +273,7 @@ void stream_update(int channel,int min_interval)
 				buf[i] = (UINT8*)(stream_buffer[channel+i]) + stream_buffer_pos[channel+i] * (stream_is_float[channel+i] ? sizeof(float) : sizeof(INT16));
 
 			profiler_mark(PROFILER_SOUND);
-			(*stream_callback_multi[channel])(stream_param[channel],buf,buflen);
+			call_stream_callback_multi(channel,buf,buflen);
 			profiler_mark(PROFILER_END);
 
 			for (i = 0;i < stream_joined_channels[channel];i++)
@@ -258,7 +284,7 @@ void stream_update(int channel,int min_interval)
 			void *buf = (UINT8*)(stream_buffer[channel]) + stream_buffer_pos[channel] * (stream_is_float[channel] ? sizeof(float) : sizeof(INT16));
 
 			profiler_mark(PROFILER_SOUND);
-			(*stream_callback[channel])(stream_param[channel],buf,buflen);
+			call_stream_callback(channel,buf,buflen);
 			profiler_mark(PROFILER_END);
 
 			stream_buffer_pos[channel] += buflen;
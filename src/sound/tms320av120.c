@@ -73,7 +73,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //MPG Stuff
 INLINE long Layer2Requant(long sample, long levels, int scaleIndex);
 static void Matrix(long *V, long *subbandSamples, int numSamples);
-static void Layer12Synthesis(  int num, long *V[16], long *subbandSamples,	int numSubbandSamples);
+static void Layer12Synthesis(  int num, long *V[16], int *Vzero, long *subbandSamples, int numSubbandSamples);
 static long GetBits(int num, int numBits);
 static void DecodeLayer2(int num);
 
@@ -106,6 +106,7 @@ struct TMS320AV120Chip
  int    stream;							//Holds stream channel assignment
  int    bitsRemaining;					//Keep track of # of bits we've read from frame buffer
  long *_V[16];							//Synthesis window for single channel
+ int    _Vzero;							//Bit n set if _V[n] is all zero
  int    mute;							//Mute status ( 0 = off, 1 = Mute )
  int	reset;							//Reset status( 0 = off, 1 = Reset)
  int	bof_line;						//BOF Line status
@@ -241,7 +242,6 @@ static long SynthesisWindowCoefficients[] = // 2.16 fixed-point values
 static struct TMS320AV120Chip tms320av120[MAX_TMS320AV120];		// Each Chip
 static const struct TMS320AV120interface *intf;					// Pointer to the interface
 static long layer1ScaleFactors[64];								// MPG Layer 1 Scale Factors
-static int bitmasks[] = {0,1,3,7,0xF,0x1F,0x3F,0x7F,0xFF};		// Bit reading masks
 //Matrix stuff
 static const char order[] = {0,16,8,24,4,20,12,28,2,18,10,26,6,22,14,30,
                              1,17,9,25,5,21,13,29,3,19,11,27,7,23,15,31};
@@ -348,55 +348,96 @@ static void Matrix(long *V, long *subbandSamples, int numSamples) {
 //Convert Layer 1 or Layer 2 subband samples into pcm samples and put into pcm buffer
 static void Layer12Synthesis(  int num,
 					    long *V[16],
+					    int *Vzero,
                         long *subbandSamples,
 						int numSubbandSamples)
 {
    INT16 *pcmSamples = &(tms320av120[num].pcmbuffer[tms320av120[num].pcm_pos]);
-   int i,j;
+   int i,j,n;
    long *t = V[15];
    long *nextD;
 
    for(i=15;i>0;i--) // Shift V buffers over
       V[i] = V[i-1];
    V[0] = t;
+   *Vzero = (*Vzero << 1) & 0xFFFF;
 
    // Convert subband samples into PCM samples in V[0]
-   Matrix(V[0],subbandSamples,numSubbandSamples);
+   // (silent subbands give an all zero V, which is common between sounds)
+   for(n=0;n<numSubbandSamples && !subbandSamples[n];n++)
+      ;
+   if(n == numSubbandSamples) {
+      memset(V[0],0,64*sizeof(long));
+      *Vzero |= 1;
+   }
+   else
+      Matrix(V[0],subbandSamples,numSubbandSamples);
 
    // D is 3.12, V is 6.9, want 16 bit output
    nextD = D;
-   for(j=0;j<32;j++) {
-      long sample = 0; // 8.16
-      for(i=0;i<16;i+=2) {
-         sample += (*nextD++ * V[i][j]) >> 8;
-         sample += (*nextD++ * V[i+1][j+32]) >> 8;
+   if(*Vzero == 0) {
+      for(j=0;j<32;j++) {
+         long sample = 0; // 8.16
+         for(i=0;i<16;i+=2) {
+            sample += (*nextD++ * V[i][j]) >> 8;
+            sample += (*nextD++ * V[i+1][j+32]) >> 8;
+         }
+         *pcmSamples++ = (INT16)(sample >> 1); // Output samples are 16 bit
+      }
+   }
+   else if(*Vzero == 0xFFFF) {
+      memset(pcmSamples,0,32*sizeof(INT16));
+   }
+   else {
+      // Leave out the all zero V buffers, their products are all 0
+      const long *rows[16];
+      int taps[16];
+      for(i=0,n=0;i<16;i++)
+         if(!(*Vzero & (1<<i))) {
+            rows[n] = V[i] + ((i & 1) ? 32 : 0);
+            taps[n++] = i;
+         }
+      for(j=0;j<32;j++) {
+         long sample = 0; // 8.16
+         for(i=0;i<n;i++)
+            sample += (nextD[taps[i]] * rows[i][j]) >> 8;
+         nextD += 16;
+         *pcmSamples++ = (INT16)(sample >> 1); // Output samples are 16 bit
       }
-      *pcmSamples++ = (INT16)(sample >> 1); // Output samples are 16 bit
    }
 }
 
-//Return bits from the frame buffer
+//Return bits (at most 16) from the frame buffer
+//fb_pos/bitsRemaining advance exactly like reading bit by bit, i.e. bitsRemaining is 0 (and not 8 of the next byte) after using up a byte
 static long GetBits(int num, int numBits) {
-   long result;
-   if(tms320av120[num].bitsRemaining == 0) { // If no bits in this byte get from next byte in frame buffer!
-      tms320av120[num].fb_pos++;				 // ...
+   struct TMS320AV120Chip *chip = &tms320av120[num];
+   UINT32 window;
+   int pos, bitOffset;
+   if(chip->bitsRemaining == 0) { // If no bits in this byte get from next byte in frame buffer!
+      chip->fb_pos++;				 // ...
 	  //Make sure we're not out of data!
-	  if(tms320av120[num].fb_pos > MPG_FRAMESIZE) {
+	  if(chip->fb_pos > MPG_FRAMESIZE) {
 		  LOG(("END OF FRAME BUFFER DATA IN GETBITS!\n"));
 		  return 0;
 	  }
-      tms320av120[num].bitsRemaining = 8;
+      chip->bitsRemaining = 8;
    }
-   if(tms320av120[num].bitsRemaining >= numBits) { // Can I fill it from this byte?
-      tms320av120[num].bitsRemaining -= numBits;
-      return (tms320av120[num].framebuff[tms320av120[num].fb_pos]>>tms320av120[num].bitsRemaining) & bitmasks[numBits];
+   // Grab the next 3 bytes at once (fb_pos wraps like a byte, anything past the frame reads as 0)
+   pos = chip->fb_pos;
+   if(pos + 2 < MPG_FRAMESIZE)
+      window = (chip->framebuff[pos] << 16) | (chip->framebuff[pos+1] << 8) | chip->framebuff[pos+2];
+   else {
+      int i;
+      window = 0;
+      for(i=0;i<3;i++) {
+         UINT8 p = (UINT8)(pos + i);
+         window = (window << 8) | ((p < MPG_FRAMESIZE) ? chip->framebuff[p] : 0);
+      }
    }
-   // Use up rest of this byte, then recurse to get more bits
-   result = (tms320av120[num].framebuff[tms320av120[num].fb_pos] & bitmasks[tms320av120[num].bitsRemaining]) << (numBits - tms320av120[num].bitsRemaining);
-   numBits -= tms320av120[num].bitsRemaining; // I don't need as many bits now
-   tms320av120[num].bitsRemaining = 8;  // Move to next bit
-   tms320av120[num].fb_pos++;
-   return result | GetBits(num,numBits);
+   bitOffset = 8 - chip->bitsRemaining + numBits; // bits used from the window afterwards
+   chip->fb_pos += (bitOffset - 1) >> 3;
+   chip->bitsRemaining = 7 - ((bitOffset - 1) & 7);
+   return (window >> (24 - bitOffset)) & ((1 << numBits) - 1);
 }
 
 //Decode an MPEG1 - Layer 2 Frame
@@ -496,11 +537,11 @@ for(sf=0;sf<3;sf++) { // Diff't scale factors for each 1/3
 			}
 		}
 		// Now, feed three sets of subband samples into synthesis engine
-		Layer12Synthesis(num,tms320av120[num]._V,sbSamples[0],sblimit);
+		Layer12Synthesis(num,tms320av120[num]._V,&tms320av120[num]._Vzero,sbSamples[0],sblimit);
 		tms320av120[num].pcm_pos += 32;
-		Layer12Synthesis(num,tms320av120[num]._V,sbSamples[1],sblimit);
+		Layer12Synthesis(num,tms320av120[num]._V,&tms320av120[num]._Vzero,sbSamples[1],sblimit);
 		tms320av120[num].pcm_pos += 32;
-		Layer12Synthesis(num,tms320av120[num]._V,sbSamples[2],sblimit);
+		Layer12Synthesis(num,tms320av120[num]._V,&tms320av120[num]._Vzero,sbSamples[2],sblimit);
 		tms320av120[num].pcm_pos += 32;
 	}	//# of groups
 }		//# of scale factors
@@ -592,6 +633,7 @@ int TMS320AV120_sh_start(const struct MachineSound *msound)
 		  for(j=0;j<64;j++)
 			tms320av120[i]._V[vi][j] = 0;
 		}
+		tms320av120[i]._Vzero = 0xFFFF;
 
 		//Open for logging data
 		#if LOG_DATA_IN	
@@ -1870,6 +1870,15 @@ static void OPM_DoIC(opm_t *chip)
 
 void OPM_Clock(opm_t *chip, int32_t *output, uint8_t *sh1, uint8_t *sh2, uint8_t *so)
 {
+#ifdef PINMAME
+    // skip the operator, mixer and DAC stages and the per slot envelope and phase
+    // generators while idle, see OPM_GenerateOne
+    if (chip->idle)
+    {
+        OPM_EnvelopeTimer(chip);
+        goto idle;
+    }
+#endif
     OPM_Mixer2(chip);
     OPM_Mixer(chip);
 
@@ -1904,6 +1913,9 @@ void OPM_Clock(opm_t *chip, int32_t *output, uint8_t *sh1, uint8_t *sh2, uint8_t
     OPM_PhaseCalcIncrement(chip);
     OPM_PhaseCalcFNumBlock(chip);
 
+#ifdef PINMAME
+idle:
+#endif
     OPM_DoTimerIRQ(chip);
     OPM_DoTimerA(chip);
     OPM_DoTimerB(chip);
@@ -1921,8 +1933,13 @@ void OPM_Clock(opm_t *chip, int32_t *output, uint8_t *sh1, uint8_t *sh2, uint8_t
     OPM_DoLFO2(chip);
     OPM_CSM(chip);
     OPM_NoiseChannel(chip);
-    OPM_Output(chip);
-    OPM_DAC(chip);
+#ifdef PINMAME
+    if (!chip->idle)
+#endif
+    {
+        OPM_Output(chip);
+        OPM_DAC(chip);
+    }
     OPM_DoIC(chip);
     if (sh1)
     {
@@ -1944,10 +1961,79 @@ void OPM_Clock(opm_t *chip, int32_t *output, uint8_t *sh1, uint8_t *sh2, uint8_t
     chip->cycles = (chip->cycles + 1) & 31;
 }
 
+#ifdef PINMAME
+// Idle fast path: once all operators are released to full attenuation and the DAC
+// output stopped changing, the operator, mixer and DAC stages only repeat the same
+// 32 cycle pattern, the per slot envelopes stay at full attenuation and the phase
+// generators are reset by the next key on anyway. So silent samples only clock the
+// timers, LFO, noise, envelope timer and register interface (keeping IRQs, CT1/CT2
+// and all free running counters exact) and repeat the last output. Any write that
+// can make the chip audible again (key on, RL, noise, CSM, test register) ends it
+// before the sample it's clocked in.
+#define OPM_IDLE_SETTLE 4 /* silent samples needed before the idle path is used */
+
+static int OPM_WriteWakes(uint8_t address, uint8_t data)
+{
+    if ((address & 0xf8) == 0x20) // RL, FB, CONNECT (RL moves the DC level)
+    {
+        return 1;
+    }
+    switch (address)
+    {
+    case 0x01: // TEST, LFO reset
+        return 1;
+    case 0x08: // key on
+        return (data & 0x78) != 0;
+    case 0x0f: // noise
+        return (data & 0x80) != 0;
+    case 0x14: // CSM
+        return (data & 0x80) != 0;
+    }
+    return 0;
+}
+
+static int OPM_IsSilent(opm_t *chip)
+{
+    uint32_t i;
+    if (chip->ic || chip->mode_csm || chip->kon_csm || chip->noise_en
+     || chip->dac_output[0] != chip->idle_output[0] || chip->dac_output[1] != chip->idle_output[1])
+    {
+        return 0;
+    }
+    for (i = 0; i < 8; i++)
+    {
+        if (chip->mode_test[i])
+        {
+            return 0;
+        }
+    }
+    for (i = 0; i < 32; i++)
+    {
+        if (chip->eg_level[i] != 0x3ff || chip->eg_state[i] != eg_num_release || chip->kon[i] || chip->mode_kon[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
+
 void OPM_Write(opm_t *chip, uint32_t port, uint8_t data)
 {
 #ifdef PINMAME
     vgm_write(chip->vgm_idx, 0x00, port, data);
+
+    if (port & 0x01)
+    {
+        if (OPM_WriteWakes(chip->idle_address, data))
+        {
+            chip->idle_samples = 0;
+        }
+    }
+    else
+    {
+        chip->idle_address = data;
+    }
 #endif
 
     chip->write_data = data;
@@ -2006,6 +2092,9 @@ void OPM_SetIC(opm_t *chip, uint8_t ic)
     if (chip->ic != ic)
     {
         chip->ic = ic;
+#ifdef PINMAME
+        chip->idle_samples = 0;
+#endif
         if (!ic)
         {
             chip->cycles = 0;
@@ -2063,7 +2152,19 @@ void OPM_WriteBuffered(opm_t *chip, uint32_t port, uint8_t data)
         }
     }
 
+    // flag writes that end the idle fast path, see OPM_GenerateOne
     chip->writebuf[chip->writebuf_last].port = (port & 0x01) | 0x02;
+    if (port & 0x01)
+    {
+        if (OPM_WriteWakes(chip->writebuf_address, data))
+        {
+            chip->writebuf[chip->writebuf_last].port |= 0x04;
+        }
+    }
+    else
+    {
+        chip->writebuf_address = data;
+    }
     chip->writebuf[chip->writebuf_last].data = data;
     time1 = chip->writebuf_lasttime + OPN_WRITEBUF_DELAY;
     time2 = chip->writebuf_samplecnt;
@@ -2081,9 +2182,22 @@ void OPM_WriteBuffered(opm_t *chip, uint32_t port, uint8_t data)
 INLINE void OPM_GenerateOne(opm_t *chip, int32_t buf[2])
 {
     uint32_t i;
+    chip->idle = chip->idle_samples >= OPM_IDLE_SETTLE;
+    if (chip->idle)
+    {
+        // a waking write clocked in during this sample may already change its output
+        for (i = chip->writebuf_cur; (chip->writebuf[i].port & 0x02) && chip->writebuf[i].time < chip->writebuf_samplecnt + 32; i = (i + 1) % OPN_WRITEBUF_SIZE)
+        {
+            if (chip->writebuf[i].port & 0x04)
+            {
+                chip->idle = 0;
+                break;
+            }
+        }
+    }
     for (i = 0; i < 32; i++) // inbetween every 32 cycles a stereo sample is created
     {
-        OPM_Clock(chip, (i == 31) ? buf : NULL, NULL, NULL, NULL); // so grab that at some point
+        OPM_Clock(chip, NULL, NULL, NULL, NULL);
 
         while (chip->writebuf[chip->writebuf_cur].time <= chip->writebuf_samplecnt)
         {
@@ -2098,6 +2212,23 @@ INLINE void OPM_GenerateOne(opm_t *chip, int32_t buf[2])
         }
         chip->writebuf_samplecnt++;
     }
+    chip->idle = 0;
+    buf[0] = chip->dac_output[0]; // grab the sample created by the last cycle
+    buf[1] = chip->dac_output[1];
+
+    if (OPM_IsSilent(chip))
+    {
+        if (chip->idle_samples < OPM_IDLE_SETTLE)
+        {
+            chip->idle_samples++;
+        }
+    }
+    else
+    {
+        chip->idle_samples = 0;
+    }
+    chip->idle_output[0] = chip->dac_output[0];
+    chip->idle_output[1] = chip->dac_output[1];
 }
 
 // PinMAME specific
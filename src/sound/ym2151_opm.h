@@ -277,6 +277,11 @@ typedef struct {
 
     // PinMAME specific
     uint8_t old_timer_irq;
+    uint8_t writebuf_address;	/* last address put into the write buffer */
+    uint8_t idle_address;	/* last address written to the chip */
+    uint32_t idle_samples;	/* number of samples the chip has been silent for */
+    uint8_t idle;		/* current sample is clocked on the idle path */
+    int32_t idle_output[2];	/* DAC output of the last sample */
     void(*irqhandler)(int irq);		/* IRQ function handler */
     mem_write_handler porthandler;	/* port write function handler */
 
@@ -382,7 +382,7 @@ static void ss_c8(unsigned char *data, unsigned size)
 }
 
 
-void state_save_save_begin(mame_file *file)
+static void ss_save_begin(mame_file *file)
 {
 	ss_module *m;
 	TRACE(logerror("Beginning save\n"));
@@ -407,6 +407,16 @@ void state_save_save_begin(mame_file *file)
 	}
 }
 
+void state_save_save_begin(mame_file *file)
+{
+	ss_save_begin(file);
+}
+
+void state_save_save_begin_mem(void)
+{
+	ss_save_begin(NULL);
+}
+
 void state_save_save_continue(void)
 {
 	ss_module *m;
@@ -446,13 +456,11 @@ void state_save_save_continue(void)
 	}
 }
 
-void state_save_save_finish(void)
+static void ss_save_header(void)
 {
 	UINT32 signature;
 	unsigned char flags = 0;
 
-	TRACE(logerror("Finishing save\n"));
-
 	signature = ss_get_signature();
 	if(Machine->sample_rate == 0.)
 		flags |= SS_NO_SOUND;
@@ -471,7 +479,13 @@ void state_save_save_finish(void)
 	ss_dump_array[0x15] = signature >> 8;
 	ss_dump_array[0x16] = signature >> 16;
 	ss_dump_array[0x17] = signature >> 24;
+}
+
+void state_save_save_finish(void)
+{
+	TRACE(logerror("Finishing save\n"));
 
+	ss_save_header();
 	mame_fwrite(ss_dump_file, ss_dump_array, ss_dump_size);
 	free(ss_dump_array);
 	ss_dump_array = 0;
@@ -479,22 +493,30 @@ void state_save_save_finish(void)
 	ss_dump_file = 0;
 }
 
-int state_save_load_begin(mame_file *file)
+UINT8 *state_save_save_finish_mem(size_t *size)
+{
+	UINT8 *image = ss_dump_array;
+
+	TRACE(logerror("Finishing save to memory\n"));
+
+	if (image)
+		ss_save_header();
+	*size = ss_dump_size;
+	ss_dump_array = 0;
+	ss_dump_size = 0;
+	return image;
+}
+
+/* validates the image in ss_dump_array and lays out the entries for loading it */
+static int ss_load_check(void)
 {
 	ss_module *m;
 	unsigned int offset = 0;
 	UINT32 signature, file_sig;
 
-	TRACE(logerror("Beginning load\n"));
-
 	signature = ss_get_signature();
 
-	ss_dump_size = mame_fsize(file);
-	ss_dump_array = malloc(ss_dump_size);
-	ss_dump_file = file;
-	mame_fread(ss_dump_file, ss_dump_array, ss_dump_size);
-
-	if(memcmp(ss_dump_array, "MAMESAVE", 8)) {
+	if(ss_dump_size < 0x18 || memcmp(ss_dump_array, "MAMESAVE", 8)) {
 		usrintf_showmessage("Error: This is not a mame save file");
 		goto bad;
 	}
@@ -538,13 +560,44 @@ int state_save_load_begin(mame_file *file)
 			}
 		}
 	}
+	if(offset > ss_dump_size) {
+		usrintf_showmessage("Error: Truncated save state");
+		goto bad;
+	}
 	return 0;
 
  bad:
 	free(ss_dump_array);
+	ss_dump_array = 0;
 	return 1;
 }
 
+int state_save_load_begin(mame_file *file)
+{
+	TRACE(logerror("Beginning load\n"));
+
+	ss_dump_size = mame_fsize(file);
+	ss_dump_array = malloc(ss_dump_size);
+	ss_dump_file = file;
+	mame_fread(ss_dump_file, ss_dump_array, ss_dump_size);
+
+	return ss_load_check();
+}
+
+int state_save_load_begin_mem(const UINT8 *image, size_t size)
+{
+	TRACE(logerror("Beginning load from memory\n"));
+
+	ss_dump_size = size;
+	ss_dump_array = malloc(size);
+	ss_dump_file = 0;
+	if (ss_dump_array == NULL)
+		return 1;
+	memcpy(ss_dump_array, image, size);
+
+	return ss_load_check();
+}
+
 void state_save_load_continue(void)
 {
 	ss_module *m;
@@ -619,3 +672,225 @@ void state_save_dump_registry(void)
 #endif
 }
 
+
+
+/* Snapshot ring
+ *
+ * Keeps the last few in-memory save states for rewinding. Only the
+ * newest image is stored in full, every older one is stored as a delta
+ * that rebuilds it from the next newer one, so dropping the oldest entry
+ * never invalidates the others. A delta is a list of records
+ * (UINT32 skip, UINT32 length, length bytes), where skip counts bytes
+ * that are the same in both images and the bytes are the older image's.
+ */
+
+typedef struct ss_snapshot {
+	UINT8 *data;
+	size_t size;		/* size of data */
+	size_t fullsize;	/* size of the rebuilt image */
+	int full;			/* data is the image itself, not a delta */
+	double time;
+} ss_snapshot;
+
+static ss_snapshot *ss_ring;
+static int ss_ring_size;
+static int ss_ring_count;
+static int ss_ring_head;		/* index of the newest entry */
+
+/* gaps shorter than a record header are cheaper to copy than to skip */
+#define SS_DELTA_MIN_GAP	(2*sizeof(UINT32))
+
+static UINT8 *ss_delta_encode(const UINT8 *newer, const UINT8 *older, size_t size, size_t *outsize)
+{
+	UINT8 *out = malloc(2*size + 2*sizeof(UINT32));
+	size_t pos = 0, o = 0;
+
+	if (out == NULL)
+		return NULL;
+
+	while (pos < size)
+	{
+		size_t start = pos, end, gap;
+		UINT32 skip, len;
+
+		/* skip over unchanged bytes */
+		while (start < size && newer[start] == older[start])
+			start++;
+		if (start == size)
+			break;
+
+		/* find the end of the changed run, swallowing short gaps */
+		end = start;
+		for (;;)
+		{
+			while (end < size && newer[end] != older[end])
+				end++;
+			for (gap = end; gap < size && gap - end < SS_DELTA_MIN_GAP && newer[gap] == older[gap]; gap++)
+				;
+			if (gap == size || gap - end >= SS_DELTA_MIN_GAP)
+				break;
+			end = gap;
+		}
+
+		skip = (UINT32)(start - pos);
+		len = (UINT32)(end - start);
+		memcpy(out + o, &skip, sizeof(skip)); o += sizeof(skip);
+		memcpy(out + o, &len, sizeof(len)); o += sizeof(len);
+		memcpy(out + o, older + start, len); o += len;
+		pos = end;
+
+		/* not worth it, the caller keeps the full image */
+		if (o >= size)
+		{
+			free(out);
+			return NULL;
+		}
+	}
+
+	*outsize = o;
+	return realloc(out, o ? o : 1);
+}
+
+static void ss_delta_apply(UINT8 *image, const UINT8 *delta, size_t size)
+{
+	size_t o = 0, pos = 0;
+
+	while (o < size)
+	{
+		UINT32 skip, len;
+		memcpy(&skip, delta + o, sizeof(skip)); o += sizeof(skip);
+		memcpy(&len, delta + o, sizeof(len)); o += sizeof(len);
+		pos += skip;
+		memcpy(image + pos, delta + o, len);
+		pos += len;
+		o += len;
+	}
+}
+
+void state_snapshot_exit(void)
+{
+	int i;
+	for (i = 0; i < ss_ring_size; i++)
+		free(ss_ring[i].data);
+	free(ss_ring);
+	ss_ring = 0;
+	ss_ring_size = ss_ring_count = ss_ring_head = 0;
+}
+
+int state_snapshot_init(int count)
+{
+	if (count == ss_ring_size)
+		return 0;
+
+	state_snapshot_exit();
+	if (count <= 0)
+		return 0;
+
+	ss_ring = calloc(count, sizeof(ss_snapshot));
+	if (ss_ring == NULL)
+		return 1;
+	ss_ring_size = count;
+	return 0;
+}
+
+int state_snapshot_count(void)
+{
+	return ss_ring_count;
+}
+
+void state_snapshot_add(UINT8 *image, size_t size, double time)
+{
+	ss_snapshot *prev, *next;
+
+	if (!ss_ring_size)
+	{
+		free(image);
+		return;
+	}
+
+	/* turn the current newest entry into a delta against the new image */
+	if (ss_ring_count)
+	{
+		prev = &ss_ring[ss_ring_head];
+		if (prev->fullsize == size)
+		{
+			size_t deltasize;
+			UINT8 *delta = ss_delta_encode(image, prev->data, size, &deltasize);
+			if (delta)
+			{
+				free(prev->data);
+				prev->data = delta;
+				prev->size = deltasize;
+				prev->full = 0;
+			}
+		}
+		ss_ring_head = (ss_ring_head + 1) % ss_ring_size;
+	}
+
+	next = &ss_ring[ss_ring_head];
+	free(next->data);
+	next->data = image;
+	next->size = next->fullsize = size;
+	next->full = 1;
+	next->time = time;
+	if (ss_ring_count < ss_ring_size)
+		ss_ring_count++;
+}
+
+/* rebuild the image age steps back (0 = newest), the caller frees it */
+UINT8 *state_snapshot_get(int age, size_t *size, double *time)
+{
+	UINT8 *image = NULL;
+	int i;
+
+	if (age < 0 || age >= ss_ring_count)
+		return NULL;
+
+	for (i = 0; i <= age; i++)
+	{
+		const ss_snapshot *s = &ss_ring[(ss_ring_head - i + ss_ring_size) % ss_ring_size];
+		if (s->full)
+		{
+			free(image);
+			image = malloc(s->fullsize);
+			if (image == NULL)
+				return NULL;
+			memcpy(image, s->data, s->fullsize);
+		}
+		else
+			ss_delta_apply(image, s->data, s->size);
+		*size = s->fullsize;
+		*time = s->time;
+	}
+	return image;
+}
+
+/* drop the age newest entries, so the one age steps back becomes the newest */
+void state_snapshot_discard(int age)
+{
+	size_t size;
+	double time;
+	UINT8 *image;
+
+	if (age <= 0 || age >= ss_ring_count)
+		return;
+
+	image = state_snapshot_get(age, &size, &time);
+	if (image == NULL)
+		return;
+	while (age--)
+	{
+		ss_snapshot *s = &ss_ring[ss_ring_head];
+		free(s->data);
+		s->data = NULL;
+		ss_ring_head = (ss_ring_head - 1 + ss_ring_size) % ss_ring_size;
+		ss_ring_count--;
+	}
+	{
+		ss_snapshot *s = &ss_ring[ss_ring_head];
+		free(s->data);
+		s->data = image;
+		s->size = s->fullsize = size;
+		s->full = 1;
+	}
+}
@@ -46,6 +46,19 @@ void state_save_load_continue(void);
 void state_save_save_finish(void);
 void state_save_load_finish(void);
 
+/* In-memory variants, the image is malloc'ed and owned by the caller */
+void state_save_save_begin_mem(void);
+UINT8 *state_save_save_finish_mem(size_t *size);
+int  state_save_load_begin_mem(const UINT8 *image, size_t size);
+
+/* Ring of in-memory snapshots for rewinding, older entries are delta encoded */
+int  state_snapshot_init(int count);
+void state_snapshot_exit(void);
+int  state_snapshot_count(void);
+void state_snapshot_add(UINT8 *image, size_t size, double time);
+UINT8 *state_snapshot_get(int age, size_t *size, double *time);
+void state_snapshot_discard(int age);
+
 /* Display function */
 void state_save_dump_registry(void);
 
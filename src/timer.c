@@ -313,7 +313,14 @@ void timer_adjust_global_time(double delta)
 		{
 			LOG(("Timer %08X fired (expire=%.9f)\n", (UINT32)timer, timer->expire));
 			profiler_mark(PROFILER_TIMER_CALLBACK);
-			(*timer->callback)(timer->callback_param);
+			if (perfcount_active)
+			{
+				cycles_t start = osd_cycles();
+				(*timer->callback)(timer->callback_param);
+				perfcount_add(PERFCOUNT_TIMER, -1, (const void *)timer->callback, 0, start);
+			}
+			else
+				(*timer->callback)(timer->callback_param);
 			profiler_mark(PROFILER_END);
 		}
 
@@ -88,6 +88,8 @@ struct rc_option pinmame_opts[] = {
 	{ "dmd_only",	NULL, rc_bool,&pmoptions.dmd_only,    "0",  0, 0,   NULL, "Show only DMD" },
 	{ "dmd_compact",NULL, rc_bool,&pmoptions.dmd_compact, "0",  0, 0,   NULL, "Show compact display" },
 	{ "dmd_antialias",NULL, rc_int,&pmoptions.dmd_antialias,  "50", 0, 100, NULL, "DMD antialias intensity [%]" },
+	{ "dcs_cache", NULL, rc_bool, &pmoptions.dcs_cache, "0", 0, 0, NULL, "Cache decoded DCS sound frames (more memory, less CPU)" },
+	{ "idle_skip", NULL, rc_bool, &pmoptions.idle_skip, "0", 0, 0, NULL, "Let the main CPU sleep in idle loops until the next interrupt (WPC, S11, DE)" },
 #ifdef PROC_SUPPORT
 	{ "alpha_on_dmd",NULL, rc_bool,&pmoptions.alpha_on_dmd, "0",  0, 0, NULL, "Emulate alphanumeric display on DMD" },
 	{ "p-roc",NULL, rc_string,&pmoptions.p_roc, "None",  0, 0, NULL, "YAML Machine description file" },
@@ -132,6 +134,12 @@ static struct rc_option opts[] = {
 	{ "skip_disclaimer", NULL, rc_bool, &options.skip_disclaimer, "0", 0, 0, NULL, "Skip displaying the disclaimer screen" },
 	{ "skip_gameinfo", NULL, rc_bool, &options.skip_gameinfo, "0", 0, 0, NULL, "Skip displaying the game info screen" },
 	{ "crconly", NULL, rc_bool, &options.crc_only, "0", 0, 0, NULL, "Use only CRC for all integrity checks" },
+#ifdef PINMAME
+	{ "romcache", NULL, rc_bool, &options.rom_cache, "0", 0, 0, NULL, "Keep the unzipped ROMs in the ROM cache directory for faster loading" },
+#endif
+	{ "perfcounters", NULL, rc_bool, &options.perf_counters, "0", 0, 0, NULL, "Count the time spent per CPU, memory handler, timer and video/sound update" },
+	{ "perftrace", NULL, rc_string, &options.perf_trace, NULL, 0, 0, NULL, "Write a Chrome/Perfetto trace of the performance counters to this file" },
+	{ "dmdrecord", NULL, rc_string, &options.dmd_record, NULL, 0, 0, NULL, "Append all DMD sub-frames with their emulated time to this file" },
 	{ "bios", NULL, rc_string, &options.bios, "default", 0, 14, NULL, "change system bios" },
 #ifdef MAME_DEBUG
 	{ "debug", "d", rc_bool, &options.mame_debug, NULL, 0, 0, NULL, "Enable/disable debugger" },
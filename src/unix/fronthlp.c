@@ -17,6 +17,8 @@ static int correct    = 0;
 static int incorrect  = 0;
 static int not_found  = 0;
 static int sortby     = 0;
+static char *verify_report_name = NULL;
+static FILE *verify_report = NULL;
 
 enum {
 	/* standard list commands */
@@ -59,6 +61,7 @@ struct rc_option frontend_list_opts[] = {
 #endif   
 	{ "verifyroms", "vr", rc_set_int, &list, NULL, VERIFY_ROMS, 0, NULL, "Verify ROMs for games matching gamename, or all, gamename may contain * and ? wildcards" },
 	{ "verifyromsets", "vrs", rc_set_int, &list, NULL, VERIFY_ROMSETS, 0, NULL, "Like -verifyroms, but less verbose" },
+	{ "verifyreport", "vrr", rc_string, &verify_report_name, NULL, 0, 0, NULL, "Write the result and the time taken of each set checked by -verifyroms or -verifyromsets as tab separated lines to this file" },
 #if (HAS_SAMPLES)
 	{ "verifysamples", "vs", rc_set_int, &list, NULL, VERIFY_SAMPLES, 0, NULL, "Like -verifyroms but verify audio samples instead" },
 	{ "verifysamplesets", "vss", rc_set_int, &list, NULL, VERIFY_SAMPLESETS, 0, NULL, "Like -verifysamples, but less verbose" },
@@ -165,7 +168,13 @@ static void frontend_verify(int driver, int rom)
 	int status;
 
 	if(rom)
+	{
+		cycles_t start = osd_cycles();
 		status = VerifyRomSet(driver, (verify_printf_proc)myprintf);
+		if (verify_report)
+			AuditReportSet(verify_report, driver, status,
+				(double)(osd_cycles() - start) / (double)osd_cycles_per_second());
+	}
 	else
 		status = VerifySampleSet(driver, (verify_printf_proc)myprintf);
 
@@ -349,6 +358,15 @@ int frontend_list(char *gamename)
 
 	fprintf(stdout_file, header[list-1]);
 
+	if ((list == VERIFY_ROMS || list == VERIFY_ROMSETS) && verify_report_name)
+	{
+		verify_report = fopen(verify_report_name, "w");
+		if (verify_report)
+			AuditReportSet(verify_report, -1, 0, 0.);
+		else
+			fprintf(stderr_file, "Error: couldn't create %s\n", verify_report_name);
+	}
+
 	for (i=0;drivers[i];i++)
 	{
 		expand_machine_driver(drivers[i]->drv, &drv);	
@@ -867,6 +885,12 @@ int frontend_list(char *gamename)
 		}
 	}
 
+	if (verify_report)
+	{
+		fclose(verify_report);
+		verify_report = NULL;
+	}
+
 	/* print footer for those -list options which need one */
 	switch(list)
 	{
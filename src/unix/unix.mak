@@ -138,8 +138,13 @@ IMGTOOL_LIBS = -lz
 ifeq ($(TARGET), mess)
 INCLUDE_PATH = -I. -Imess -Isrc -Isrc/includes -Isrc/unix -I$(OBJ)/cpu/m68000 -Isrc/cpu/m68000
 else
+ifdef LIBPINMAME
+# libpinmame shares the OS layer headers of the windows build
+INCLUDE_PATH = -I. -Isrc -Isrc/includes -Isrc/dll -Isrc/windows -I$(OBJ)/cpu/m68000 -Isrc/cpu/m68000
+else
 INCLUDE_PATH = -I. -Isrc -Isrc/includes -Isrc/unix -I$(OBJ)/cpu/m68000 -Isrc/cpu/m68000
 endif
+endif
 
 ##############################################################################
 # "Calculate" the final CFLAGS, unix CONFIG, LIBS and OBJS
@@ -148,7 +153,11 @@ ifdef ZLIB
 ZLIB    = src/unix/contrib/cutzlib-1.1.4/libz.a
 endif
 
+ifdef LIBPINMAME
+all: $(ZLIB) objdirs $(NAME).a pinmamebatch pinmamebench
+else
 all: $(ZLIB) objdirs osdepend $(NAME).$(DISPLAY_METHOD)
+endif
 
 # CPU core include paths
 VPATH=src $(wildcard src/cpu/*)
@@ -188,17 +197,23 @@ DBGDEFS =
 DBGOBJS =
 endif
 
+ifdef LIBPINMAME
+OSDEFS = -DLIBPINMAME -D_stricmp=strcasecmp
+else
+OSDEFS = -D$(DISPLAY_METHOD) -DXMAME -DUNIX
+endif
+
 # Perhaps one day original mame/mess sources will use POSIX strcasecmp and
 # M_PI instead MS-DOS counterparts... ( a long and sad history ...)
 # bcd - added DEFS to the list
 MY_CFLAGS = $(CFLAGS) $(IL) $(CFLAGS.$(MY_CPU)) \
-	-D__ARCH_$(ARCH) -D__CPU_$(MY_CPU) -D$(DISPLAY_METHOD) \
+	-D__ARCH_$(ARCH) -D__CPU_$(MY_CPU) $(OSDEFS) \
 	-Dstricmp=strcasecmp -Dstrnicmp=strncasecmp \
-	-DPI=M_PI -DXMAME -DUNIX -DSIGNED_SAMPLES -DCLIB_DECL= \
+	-DPI=M_PI -DSIGNED_SAMPLES -DCLIB_DECL= \
 	$(COREDEFS) $(SOUNDDEFS) $(CPUDEFS) $(ASMDEFS) $(DEFS)\
 	$(INCLUDES) $(INCLUDE_PATH)
 
-MY_LIBS = $(LIBS) $(LIBS.$(ARCH)) $(LIBS.$(DISPLAY_METHOD)) -lz
+MY_LIBS = $(LIBS) $(LIBS.$(ARCH)) $(LIBS.$(DISPLAY_METHOD)) -lz -lpthread
 
 ifdef PROC
 MY_LIBS += -lyaml-cpp -lpinproc -lftdi1 -lusb
@@ -315,6 +330,20 @@ endif
 OBJS  += $(subst $(OBJ)/vidhrdw/vector.o, ,$(COREOBJS)) $(DRVLIBS) \
  $(OBJ)/unix.$(DISPLAY_METHOD)/osdepend.a $(OBJ)/unix.$(DISPLAY_METHOD)/vector.o
 
+ifdef LIBPINMAME
+# the src/dll OS layer (plus the unix timing code) replaces
+# osdepend.a, the tools link against the resulting static library
+LIBPINMAME_OBJS = $(OBJ)/dll/libpinmame.o $(OBJ)/dll/fileio.o \
+	$(OBJ)/dll/joystick.o $(OBJ)/dll/keyboard.o $(OBJ)/dll/minimalconfig.o \
+	$(OBJ)/dll/misc.o $(OBJ)/dll/sound.o $(OBJ)/dll/video.o \
+	$(OBJ)/windows/fronthlp.o $(OBJ)/windows/rc.o \
+	$(OBJ)/unix/ticker.o
+LIBPINMAME_OBJS += $(subst $(OBJ)/vidhrdw/vector.o, ,$(COREOBJS)) \
+	$(subst $(OBJ)/allgames.a,$(PINGAMES),$(DRVLIBS)) \
+	$(OBJ)/dll/vector.o $(OBJ)/dll/vgmwrite.o
+OBJDIRS += $(OBJ)/dll $(OBJ)/windows $(OBJ)/unix
+endif
+
 MY_OBJDIRS = $(CORE_OBJDIRS) $(sort $(OBJDIRS))
 
 ##############################################################################
@@ -324,6 +353,17 @@ $(NAME).$(DISPLAY_METHOD): $(OBJS) $(PROCOBJS) $(LISYOBJS)
 	$(CC_COMMENT) @echo 'Linking $@ ...'
 	$(CC_COMPILE) $(LD) $(LDFLAGS) -o $@ $(OBJS) $(PROCOBJS) $(LISYOBJS) $(MY_LIBS) 
 
+# two members are named fileio.o, so never update the archive in place
+$(NAME).a: $(LIBPINMAME_OBJS)
+	$(CC_COMMENT) @echo 'Archiving $@ ...'
+	$(CC_COMPILE) rm -f $@
+	$(CC_COMPILE) ar $(AR_OPTS) $@ $^
+	$(CC_COMPILE) $(RANLIB) $@
+
+pinmamebatch pinmamebench: %: $(OBJ)/dll/%.o $(NAME).a
+	$(CC_COMMENT) @echo 'Linking $@ ...'
+	$(CC_COMPILE) $(LD) $(LDFLAGS) -o $@ $^ $(LIBS) $(LIBS.$(ARCH)) -lz -lpthread
+
 tools: $(ZLIB) $(OBJDIRS) $(TOOLS)
 
 objdirs: $(MY_OBJDIRS)
@@ -380,6 +420,22 @@ $(PROC_OBJ)/%.o: src/p-roc/%.cpp
 	$(CC_COMMENT) @echo 'Compiling $< ...'
 	$(CC_COMPILE) $(CPP) $(MY_CFLAGS) -o $@ -c $<
 
+$(OBJ)/dll/%.o: src/dll/%.cpp
+	$(CC_COMMENT) @echo 'Compiling $< ...'
+	$(CC_COMPILE) $(CPP) $(filter-out -std=gnu99,$(MY_CFLAGS)) $(CPPFLAGS) -o $@ -c $<
+
+$(OBJ)/unix/%.o: src/unix/%.c
+	$(CC_COMMENT) @echo 'Compiling $< ...'
+	$(CC_COMPILE) $(CC) $(MY_CFLAGS) -Isrc/unix -o $@ -c $<
+
+$(OBJ)/dll/vector.o: src/vidhrdw/vector.c
+	$(CC_COMMENT) @echo 'Compiling $< ...'
+	$(CC_COMPILE) $(CC) $(MY_CFLAGS) -o $@ -c $<
+
+$(OBJ)/dll/vgmwrite.o: ext/vgm/vgmwrite.c
+	$(CC_COMMENT) @echo 'Compiling $< ...'
+	$(CC_COMPILE) $(CC) $(MY_CFLAGS) -o $@ -c $<
+
 $(LISY_OBJ)/%.o: src/lisy/%.c
 	$(CC_COMMENT) @echo 'Compiling $< ...'
 	$(CC_COMPILE) $(CC) $(MY_CFLAGS) -o $@ -c $<
@@ -492,6 +548,9 @@ copycab:
 
 clean: 
 	rm -fr $(OBJ) $(NAME).* xlistdev src/unix/contrib/cutzlib-1.1.4/libz.a src/unix/contrib/cutzlib-1.1.4/*.o $(TOOLS)
+ifdef LIBPINMAME
+	rm -f pinmamebatch pinmamebench
+endif
 #	cd makedep; make clean
 
 clean68k:
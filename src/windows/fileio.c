@@ -112,6 +112,7 @@ struct rc_option fileio_opts[] =
 	{ "ctrlr_directory", NULL, rc_string, &pathlist[FILETYPE_CTRLR].rawpath, "ctrlr", 0, 0, NULL, "directory to save controller definitions" },
 #ifdef PINMAME
 	{ "wave_directory", NULL, rc_string, &pathlist[FILETYPE_WAVE].rawpath, "wave", 0, 0, NULL, "directory for wave files" },
+	{ "romcache_directory", NULL, rc_string, &pathlist[FILETYPE_ROMCACHE].rawpath, "romcache", 0, 0, NULL, "directory for the unzipped ROM cache" },
 #endif /* PINMAME */
 	{ "cheat_file", NULL, rc_string, &cheatfile, "cheat.dat", 0, 0, NULL, "cheat filename" },
 	{ "history_file", NULL, rc_string, &history_filename, "history.dat", 0, 0, NULL, NULL },
@@ -54,6 +54,7 @@ static int verify = 0;
 static int ident = 0;
 static int help = 0;
 static int sortby = 0;
+static char *verify_report_name = NULL;
 
 struct rc_option frontend_opts[] = {
 	{ "Frontend Related", NULL,	rc_seperator, NULL, NULL, 0, 0,	NULL, NULL },
@@ -103,6 +104,7 @@ struct rc_option frontend_opts[] = {
 	{ "verifyroms", NULL, rc_set_int, &verify, NULL, VERIFY_ROMS, 0, NULL, "report romsets that have problems" },
 	{ "verifysets", NULL, rc_set_int, &verify, NULL, VERIFY_ROMS|VERIFY_VERBOSE|VERIFY_TERSE, 0, NULL, "verify checksums of romsets (terse)" },
 	{ "vset", NULL, rc_set_int, &verify, NULL, VERIFY_ROMS|VERIFY_VERBOSE, 0, NULL, "verify checksums of a romset (verbose)" },
+	{ "verifyreport", NULL, rc_string, &verify_report_name, NULL, 0, 0, NULL, "write the result and time taken of each verified romset as tab separated lines to this file" },
 	{ "verifysamples", NULL, rc_set_int, &verify, NULL, VERIFY_SAMPLES|VERIFY_VERBOSE, 0, NULL, "report samplesets that have problems" },
 	{ "vsam", NULL, rc_set_int, &verify, NULL, VERIFY_SAMPLES|VERIFY_VERBOSE, 0, NULL, "verify a sampleset" },
 	{ "romident", NULL, rc_set_int, &ident, NULL, 1, 0, NULL, "compare files with known MAME roms" },
@@ -1646,7 +1648,16 @@ j = 0;	// count only the main cpu
 		int total = 0;
 		int checked = 0;
 		int notfound = 0;
+		FILE *report = NULL;
 
+		if ((verify & VERIFY_ROMS) && verify_report_name)
+		{
+			report = fopen(verify_report_name, "w");
+			if (report)
+				AuditReportSet(report, -1, 0, 0.);
+			else
+				fprintf(stderr, "couldn't create %s\n", verify_report_name);
+		}
 
 		for (i = 0; drivers[i]; i++)
 		{
@@ -1664,7 +1675,11 @@ j = 0;	// count only the main cpu
 
 			if (verify & VERIFY_ROMS)
 			{
+				cycles_t start = osd_cycles();
+
 				res = VerifyRomSet (i,(verify & VERIFY_TERSE) ? terse_printf : (verify_printf_proc)printf);
+				if (report)
+					AuditReportSet(report, i, res, (double)(osd_cycles() - start) / (double)osd_cycles_per_second());
 
 				if (res == CLONE_NOTFOUND || res == NOTFOUND)
 				{
@@ -1733,6 +1748,9 @@ nextloop:
 			fprintf(stderr,"%d%%\r",100 * checked / total);
 		}
 
+		if (report)
+			fclose(report);
+
 		if (correct+incorrect == 0)
 		{
 			printf ("%s ", (verify & VERIFY_ROMS) ? "romset" : "sampleset" );
@@ -4,6 +4,7 @@
 #include "sndbrd.h"
 #include "alvg.h"
 #include "alvgdmd.h"
+#include "dmdrec.h"
 
 #ifdef VERBOSE
 #define LOG(x)	logerror x
@@ -276,6 +277,13 @@ static READ_HANDLER(dmd32_latch_r) {
 
 //Pulse the INT1 Line
 static INTERRUPT_GEN(dmd32_firq) {
+	/*-- the planes alvgdmd_update (World Tour) or pistol_poker__mystery_castle_dmd show --*/
+	if (!dmdlocals.planenable)
+		dmdrec_subFrame(0, 128, 32, 1, 1, DMDREC_WEIGHTS(1,0,0,0), dmd32RAM + (dmdlocals.vid_page << 11), 0x200, DMDREC_MSBFIRST);
+	else if (core_gameData->gen == GEN_ALVG_DMD2)
+		dmdrec_subFrame(0, 128, 32, 1, 4, DMDREC_WEIGHTS(1,1,1,1), dmd32RAM + (dmdlocals.vid_page << 11), 0x200, DMDREC_MSBFIRST);
+	else
+		dmdrec_subFrame(0, 128, 32, 1, 2, DMDREC_WEIGHTS(1,2,0,0), dmd32RAM + (dmdlocals.vid_page << 11), 0x200, DMDREC_MSBFIRST);
 	if(dmdlocals.setsync) {
 		LOG(("INT1 Pulse\n"));
 		cpu_set_irq_line(dmdlocals.brdData.cpuNo, I8051_INT1_LINE, PULSE_LINE);
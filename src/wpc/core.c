@@ -2,11 +2,13 @@
 /* PINMAME - Interface function (Input/Output) */
 /***********************************************/
 #include <stdarg.h>
+#include <math.h>
 #include "driver.h"
 #include "sim.h"
 #include "snd_cmd.h"
 #include "mech.h"
 #include "core.h"
+#include "dmdrec.h"
 #include "video.h"
 
 #ifdef PROC_SUPPORT
@@ -29,6 +31,14 @@
  static UINT8 *currbuffer = buffer1;
  static UINT8 *oldbuffer = NULL;
  static UINT32 raw_dmdoffs = 0;
+ UINT8  g_raw_dmd_dirtyrows[DMD_MAXY]; // raw DMD rows changed since the frontend last fetched them
+
+ /*-- raw DMD brightness/color tables, only rebuilt when the DMD options change --*/
+ static struct {
+   int    key[18];  // options the tables were built from
+   UINT8  raw_4[4], raw_16[16];
+   UINT32 palette32_4[4], palette32_16[16];
+ } dmdPal;
 
  #include "gts3dmd.h"
  UINT8  g_raw_gtswpc_dmd[GTS3DMD_FRAMES_5C*0x200];
@@ -60,11 +70,23 @@ void vp_setDIP(int bank, int value) { }
   extern int g_fDumpFrames;
   extern void OnSolenoid(int nSolenoid, int IsActive);
   extern void OnStateChange(int nChange);
+ #if defined(PINMAME_DLL) || defined(LIBPINMAME)
+  extern void OnOutputsUpdated(void);
+  extern void OnDMDFrame(int width, int height, int shades);
+  extern void OnSegmentFrame(const UINT16 *segments, int count);
+ #else
+  #define OnOutputsUpdated()
+  #define OnDMDFrame(width, height, shades)
+  #define OnSegmentFrame(segments, count)
+ #endif
 #else /* VPINMAME */
   int g_fHandleKeyboard = 1;
   int g_fHandleMechanics = 0xff;
   #define OnSolenoid(nSolenoid, IsActive)
   #define OnStateChange(nChange)
+  #define OnOutputsUpdated()
+  #define OnDMDFrame(width, height, shades)
+  #define OnSegmentFrame(segments, count)
   #define vp_getSolMask64() ((UINT64)(-1))
   #define vp_updateMech()
   #define vp_setDIP(x,y)
@@ -666,6 +688,7 @@ static struct {
   int       firstSimRow, maxSimRows; // space available for simulator
   int       solLog[4];
   int       solLogCount;
+  int       dmdShade16;    // DMD uses 16 shades instead of 4
 } locals;
 
 /*-------------------------------
@@ -782,87 +805,101 @@ static PALETTE_INIT(core) {
     palette_set_color(ii, tmpPalette[ii][0], tmpPalette[ii][1], tmpPalette[ii][2]);
 }
 
-/*-----------------------------------
-/    Generic DMD display handler
-/------------------------------------*/
-void video_update_core_dmd(struct mame_bitmap *bitmap, const struct rectangle *cliprect, const struct core_dispLayout *layout) {
-
-  UINT32 *dmdColor = &CORE_COLOR(COL_DMDOFF);
-  UINT32 *aaColor  = &CORE_COLOR(COL_DMDAA);
-  BMTYPE **lines = ((BMTYPE **)bitmap->line) + (layout->top*locals.displaySize);
-  int noaa = !pmoptions.dmd_antialias || (layout->type & CORE_DMDNOAA);
-  int ii, jj;
-
-  // prepare all brightness & color/palette tables for mappings from internal DMD representation:
-  const int shade_16_enabled = ((core_gameData->gen == GEN_SAM) ||
-	  // extended handling also for some GTS3 games (SMB, SMBMW and CBW):
-	  (strncasecmp(Machine->gamedrv->name, "smb", 3) == 0) || (strncasecmp(Machine->gamedrv->name, "cueball", 7) == 0) ||
-	  (core_gameData->gen == GEN_ALVG_DMD2));
-
 #if defined(VPINMAME) || defined(PINMAME_DLL) || defined(LIBPINMAME)
-
-  const UINT8 perc0 = (pmoptions.dmd_perc0  > 0) ? pmoptions.dmd_perc0  : 20;
-  const UINT8 perc1 = (pmoptions.dmd_perc33 > 0) ? pmoptions.dmd_perc33 : 33;
-  const UINT8 perc2 = (pmoptions.dmd_perc66 > 0) ? pmoptions.dmd_perc66 : 67;
-  const UINT8 perc3 = 100;
-
+/*-----------------------------------------------------
+/  (Re)build the raw DMD brightness and color tables,
+/  returns TRUE if they changed
+/-----------------------------------------------------*/
+static int dmdPaletteUpdate(void) {
   static const int levelgts3[16] = {0/*5*/, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80, 85, 90, 95, 100}; // GTS3 and AlvinG brightness seems okay
   static const int levelsam[16]  = {0/*5*/, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80, 90, 100}; // SAM brightness seems okay
+  const int key[18] = {
+    pmoptions.dmd_red, pmoptions.dmd_green, pmoptions.dmd_blue,
+    pmoptions.dmd_perc0, pmoptions.dmd_perc33, pmoptions.dmd_perc66, pmoptions.dmd_colorize,
+    pmoptions.dmd_red0, pmoptions.dmd_green0, pmoptions.dmd_blue0,
+    pmoptions.dmd_red33, pmoptions.dmd_green33, pmoptions.dmd_blue33,
+    pmoptions.dmd_red66, pmoptions.dmd_green66, pmoptions.dmd_blue66,
+    core_gameData->gen == GEN_SAM, 1 /* never all zero, so the first call always builds */
+  };
+  const int *level;
+  unsigned char palette[4][3];
+  int rStart = 0xFF, gStart = 0xE0, bStart = 0x20;
+  int ii;
 
-  const int * const level = (core_gameData->gen == GEN_SAM) ? levelsam : levelgts3;
+  if (memcmp(key, dmdPal.key, sizeof(key)) == 0)
+    return FALSE;
+  memcpy(dmdPal.key, key, sizeof(key));
 
-  const UINT8 raw_4[4]   = {perc0,perc1,perc2,perc3};
-  const UINT8 raw_16[16] = {level[0],level[1],level[2],level[3],level[4],level[5],level[6],level[7],level[8],level[9],level[10],level[11],level[12],level[13],level[14],level[15]};
+  level = (core_gameData->gen == GEN_SAM) ? levelsam : levelgts3;
 
-  UINT32 palette32_4[4];
-  UINT32 palette32_16[16];
-  unsigned char palette[4][3];
+  dmdPal.raw_4[0] = (pmoptions.dmd_perc0  > 0) ? pmoptions.dmd_perc0  : 20;
+  dmdPal.raw_4[1] = (pmoptions.dmd_perc33 > 0) ? pmoptions.dmd_perc33 : 33;
+  dmdPal.raw_4[2] = (pmoptions.dmd_perc66 > 0) ? pmoptions.dmd_perc66 : 67;
+  dmdPal.raw_4[3] = 100;
+  for (ii = 0; ii < 16; ++ii)
+    dmdPal.raw_16[ii] = level[ii];
 
-  int rStart = 0xFF, gStart = 0xE0, bStart = 0x20;
   if ((pmoptions.dmd_red > 0) || (pmoptions.dmd_green > 0) || (pmoptions.dmd_blue > 0)) {
-	  rStart = pmoptions.dmd_red; gStart = pmoptions.dmd_green; bStart = pmoptions.dmd_blue;
+    rStart = pmoptions.dmd_red; gStart = pmoptions.dmd_green; bStart = pmoptions.dmd_blue;
   }
 
   /*-- Autogenerate DMD Color Shades--*/
-  palette[0][0] = rStart * perc0 / 100;
-  palette[0][1] = gStart * perc0 / 100;
-  palette[0][2] = bStart * perc0 / 100;
-  palette[1][0] = rStart * perc1 / 100;
-  palette[1][1] = gStart * perc1 / 100;
-  palette[1][2] = bStart * perc1 / 100;
-  palette[2][0] = rStart * perc2 / 100;
-  palette[2][1] = gStart * perc2 / 100;
-  palette[2][2] = bStart * perc2 / 100;
-  palette[3][0] = rStart * perc3 / 100;
-  palette[3][1] = gStart * perc3 / 100;
-  palette[3][2] = bStart * perc3 / 100;
+  for (ii = 0; ii < 4; ++ii) {
+    palette[ii][0] = rStart * dmdPal.raw_4[ii] / 100;
+    palette[ii][1] = gStart * dmdPal.raw_4[ii] / 100;
+    palette[ii][2] = bStart * dmdPal.raw_4[ii] / 100;
+  }
 
   /*-- If the "colorize" option is set, use the individual option colors for the shades --*/
   if (pmoptions.dmd_colorize) {
-	  if (pmoptions.dmd_red0 > 0 || pmoptions.dmd_green0 > 0 || pmoptions.dmd_blue0 > 0) {
-		  palette[0][0] = pmoptions.dmd_red0;
-		  palette[0][1] = pmoptions.dmd_green0;
-		  palette[0][2] = pmoptions.dmd_blue0;
-	  }
-	  if (pmoptions.dmd_red33 > 0 || pmoptions.dmd_green33 > 0 || pmoptions.dmd_blue33 > 0) {
-		  palette[1][0] = pmoptions.dmd_red33;
-		  palette[1][1] = pmoptions.dmd_green33;
-		  palette[1][2] = pmoptions.dmd_blue33;
-	  }
-	  if (pmoptions.dmd_red66 > 0 || pmoptions.dmd_green66 > 0 || pmoptions.dmd_blue66 > 0) {
-		  palette[2][0] = pmoptions.dmd_red66;
-		  palette[2][1] = pmoptions.dmd_green66;
-		  palette[2][2] = pmoptions.dmd_blue66;
-	  }
+    if (pmoptions.dmd_red0 > 0 || pmoptions.dmd_green0 > 0 || pmoptions.dmd_blue0 > 0) {
+      palette[0][0] = pmoptions.dmd_red0;
+      palette[0][1] = pmoptions.dmd_green0;
+      palette[0][2] = pmoptions.dmd_blue0;
+    }
+    if (pmoptions.dmd_red33 > 0 || pmoptions.dmd_green33 > 0 || pmoptions.dmd_blue33 > 0) {
+      palette[1][0] = pmoptions.dmd_red33;
+      palette[1][1] = pmoptions.dmd_green33;
+      palette[1][2] = pmoptions.dmd_blue33;
+    }
+    if (pmoptions.dmd_red66 > 0 || pmoptions.dmd_green66 > 0 || pmoptions.dmd_blue66 > 0) {
+      palette[2][0] = pmoptions.dmd_red66;
+      palette[2][1] = pmoptions.dmd_green66;
+      palette[2][2] = pmoptions.dmd_blue66;
+    }
   }
 
   for (ii = 0; ii < 4; ++ii)
-     palette32_4[ii] = (UINT32)palette[ii][0] | (((UINT32)palette[ii][1]) << 8) | (((UINT32)palette[ii][2]) << 16);
+    dmdPal.palette32_4[ii] = (UINT32)palette[ii][0] | (((UINT32)palette[ii][1]) << 8) | (((UINT32)palette[ii][2]) << 16);
+
+  for (ii = 0; ii < 16; ++ii)
+    dmdPal.palette32_16[ii] = (rStart*level[ii]/100) | ((gStart*level[ii]/100) << 8) | ((bStart*level[ii]/100) << 16);
 
-  for(ii = 0; ii < 16; ++ii)
-     palette32_16[ii] = (rStart*level[ii]/100) | ((gStart*level[ii]/100) << 8) | ((bStart*level[ii]/100) << 16);
+  return TRUE;
+}
+#endif /* VPINMAME || PINMAME_DLL || LIBPINMAME */
+
+/*-----------------------------------
+/    Generic DMD display handler
+/------------------------------------*/
+void video_update_core_dmd(struct mame_bitmap *bitmap, const struct rectangle *cliprect, const struct core_dispLayout *layout) {
+
+  UINT32 *dmdColor = &CORE_COLOR(COL_DMDOFF);
+  UINT32 *aaColor  = &CORE_COLOR(COL_DMDAA);
+  BMTYPE **lines = ((BMTYPE **)bitmap->line) + (layout->top*locals.displaySize);
+  int noaa = !pmoptions.dmd_antialias || (layout->type & CORE_DMDNOAA);
+  int ii, jj;
+
+#if defined(VPINMAME) || defined(PINMAME_DLL) || defined(LIBPINMAME)
+  const UINT8  *rawLevel;
+  const UINT32 *rawColor;
+  int fullUpdate, frameChanged = 0;
+  static const struct core_dispLayout *lastLayout = NULL;
 
-  //
+  fullUpdate = dmdPaletteUpdate() || (oldbuffer == NULL) || (layout != lastLayout);
+  lastLayout = layout;
+  rawLevel = locals.dmdShade16 ? dmdPal.raw_16 : dmdPal.raw_4;
+  rawColor = locals.dmdShade16 ? dmdPal.palette32_16 : dmdPal.palette32_4;
 
   if(layout->length >= 128) // Capcom hack
   {
@@ -888,20 +925,34 @@ void video_update_core_dmd(struct mame_bitmap *bitmap, const struct rectangle *c
     BMTYPE *line = (*lines++) + (layout->left*locals.displaySize);
     coreGlobals.dotCol[ii][layout->length] = 0;
     if (ii > 0) {
-      for (jj = 0; jj < layout->length; jj++) {
-        const UINT8 col = coreGlobals.dotCol[ii][jj];
+      const UINT8 * const dots = &coreGlobals.dotCol[ii][0];
+      const UINT32 * const bmColor = locals.dmdShade16 ? dmdColor+63 : dmdColor;
 #if defined(VPINMAME) || defined(PINMAME_DLL) || defined(LIBPINMAME)
-        const int offs = (ii-1)*layout->length + jj;
-        currbuffer[offs] = col;
-        if(layout->length >= 128) { // Capcom hack
-          g_raw_dmdbuffer[offs + raw_dmdoffs] = shade_16_enabled ? raw_16[col] : raw_4[col];
-          g_raw_colordmdbuffer[offs + raw_dmdoffs] = shade_16_enabled ? palette32_16[col] : palette32_4[col];
+      /*-- compare row by row, so only the rows that changed get converted --*/
+      const int offs = (ii-1)*layout->length;
+      const int rowChanged = (oldbuffer == NULL) || memcmp(oldbuffer + offs, dots, layout->length);
+      memcpy(currbuffer + offs, dots, layout->length);
+      frameChanged |= rowChanged;
+      if ((rowChanged || fullUpdate) && layout->length >= 128) { // Capcom hack
+        UINT8  * const rawDots   = g_raw_dmdbuffer + offs + raw_dmdoffs;
+        UINT32 * const rawColors = g_raw_colordmdbuffer + offs + raw_dmdoffs;
+        for (jj = 0; jj < layout->length; jj++) {
+          rawDots[jj]   = rawLevel[dots[jj]];
+          rawColors[jj] = rawColor[dots[jj]];
         }
+        g_raw_dmd_dirtyrows[(offs + raw_dmdoffs) / layout->length] = 1;
+      }
 #endif
-        *line++ = shade_16_enabled ? dmdColor[col+63] : dmdColor[col];
-        if (locals.displaySize > 1 && jj < layout->length-1)
-          *line++ = noaa ? 0 : aaColor[col + coreGlobals.dotCol[ii][jj+1]];
+      if (locals.displaySize > 1) {
+        for (jj = 0; jj < layout->length-1; jj++) {
+          *line++ = bmColor[dots[jj]];
+          *line++ = noaa ? 0 : aaColor[dots[jj] + dots[jj+1]];
+        }
+        *line++ = bmColor[dots[jj]];
       }
+      else
+        for (jj = 0; jj < layout->length; jj++)
+          *line++ = bmColor[dots[jj]];
     }
     if (locals.displaySize > 1) {
       int col1 = coreGlobals.dotCol[ii][0] + coreGlobals.dotCol[ii+1][0];
@@ -929,9 +980,10 @@ void video_update_core_dmd(struct mame_bitmap *bitmap, const struct rectangle *c
  #endif
 
 	  if (oldbuffer != NULL) {	  // detect if same frame again
-		  if (memcmp(oldbuffer, currbuffer, (layout->length * layout->start)))
+		  if (frameChanged)
 		  {
 			  g_needs_DMD_update = 1;
+			  OnDMDFrame(g_raw_dmdx, g_raw_dmdy, locals.dmdShade16 ? 16 : 4);
 
  #ifndef LIBPINMAME
 			  if ((g_fShowPinDMD && g_fShowWinDMD) || g_fDumpFrames)	// output dump frame to .txt
@@ -1169,6 +1221,8 @@ VIDEO_UPDATE(core_gen) {
 #endif
   updateDisplay(bitmap, cliprect, core_gameData->lcdLayout, &count);
   memcpy(locals.lastSeg, coreGlobals.segments, sizeof(locals.lastSeg));
+  if (count > 0)
+    OnSegmentFrame(coreGlobals.drawSeg, count);
 #ifdef PROC_SUPPORT
 	}
 	if (coreGlobals.p_rocEn) {
@@ -1305,6 +1359,8 @@ void core_updateSw(int flipEn) {
       }
     }
   }
+  /*-- let the frontend report changed lamps/GI from the emulation thread --*/
+  OnOutputsUpdated();
 
   /*-- check if we should use simulator keys --*/
   if (g_fHandleKeyboard &&
@@ -1767,6 +1823,185 @@ static void drawChar(struct mame_bitmap *bitmap, int row, int col, UINT32 bits,
   osd_mark_dirty(col,row,col+s->cols,row+s->rows);
 }
 
+/*-------------------------------------------------------------
+/  Sub-frame output integrator
+/
+/  The driver samples the drive state of a whole output group
+/  (lamp matrix, solenoids, GI strings) at the hardware strobe
+/  rate and each output runs through a first order model of its
+/  bulb or LED, with separate heat up and cool down time constants.
+/  The drive level is multiplied by the output's gain before, so
+/  a matrix lamp that is strobed 1/8 of the time with a gain of 8
+/  settles at full brightness like the real bulb on its overdriven
+/  supply.
+/  The coefficients only change with the sample interval, so they
+/  are kept per output and all loops run over the plain float
+/  arrays of a group to let the compiler vectorise them.
+/  The 16 bit intensities are published after each sample and can
+/  be read from any thread. Model changes from the frontend are
+/  queued and applied by the next sample on the emulation thread.
+/--------------------------------------------------------------*/
+static const struct {
+  float riseTime, fallTime; /* time constants in seconds */
+} pwmModels[CORE_PWM_MODELS] = {
+  { 0.010f, 0.025f }, /* CORE_PWM_BULB */
+  { 0.015f, 0.045f }, /* CORE_PWM_FLASHER */
+  { 0.001f, 0.001f }  /* CORE_PWM_LED */
+};
+
+static struct {
+  int    count;              /* outputs in use, 0 = group not sampled by the driver */
+  double lastTime;           /* time of the last sample, < 0 = none yet */
+  double dt;                 /* sample interval the coefficients are calculated for */
+  UINT8  model[CORE_PWM_MAXOUT];
+  float  gain[CORE_PWM_MAXOUT];
+  float  rise[CORE_PWM_MAXOUT], fall[CORE_PWM_MAXOUT];
+  float  level[CORE_PWM_MAXOUT], in[CORE_PWM_MAXOUT];
+  volatile UINT16 out[CORE_PWM_MAXOUT];
+} pwmlocals[CORE_PWM_GROUPS];
+
+/*-- single producer (frontend) / single consumer (emulation thread) ring of model changes --*/
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+ #define PWM_LOAD_ACQUIRE(p)      ((int)_InterlockedCompareExchange((volatile long*)(p), 0, 0))
+ #define PWM_STORE_RELEASE(p, v)  _InterlockedExchange((volatile long*)(p), (long)(v))
+#elif defined(__GNUC__)
+ #define PWM_LOAD_ACQUIRE(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+ #define PWM_STORE_RELEASE(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else // older compilers on x86 only, where the stores aren't reordered
+ #define PWM_LOAD_ACQUIRE(p)      (*(p))
+ #define PWM_STORE_RELEASE(p, v)  (*(p) = (v))
+#endif
+#define PWM_QUEUESIZE 16
+static struct {
+  int group, first, count, model;
+  float gain;
+} pwmQueue[PWM_QUEUESIZE];
+static volatile int pwmQueueHead, pwmQueueTail; /* written by the frontend / the emulation thread */
+
+static void pwm_setModel(int group, int first, int count, int model, float gain) {
+  int ii;
+  if (first < 0) { count += first; first = 0; }
+  if (first + count > pwmlocals[group].count) count = pwmlocals[group].count - first;
+  for (ii = first; ii < first + count; ii++) {
+    pwmlocals[group].model[ii] = model;
+    pwmlocals[group].gain[ii] = gain;
+  }
+  pwmlocals[group].dt = 0.0; /* recalculate the coefficients on the next sample */
+}
+
+void core_pwm_init(int group, int count, int model, float gain) {
+  if (group < 0 || group >= CORE_PWM_GROUPS || model < 0 || model >= CORE_PWM_MODELS) return;
+  if (count > CORE_PWM_MAXOUT) count = CORE_PWM_MAXOUT;
+  memset(&pwmlocals[group], 0, sizeof(pwmlocals[group]));
+  pwmlocals[group].lastTime = -1.0;
+  pwmlocals[group].count = count;
+  pwm_setModel(group, 0, count, model, gain);
+}
+
+/*-- may be called from any one frontend thread, returns 0 if the queue is full --*/
+int core_pwm_setModel(int group, int first, int count, int model, float gain) {
+  const int head = pwmQueueHead;
+  if (group < 0 || group >= CORE_PWM_GROUPS || model < 0 || model >= CORE_PWM_MODELS) return 0;
+  if ((head + 1) % PWM_QUEUESIZE == PWM_LOAD_ACQUIRE(&pwmQueueTail)) return 0;
+  pwmQueue[head].group = group;
+  pwmQueue[head].first = first;
+  pwmQueue[head].count = count;
+  pwmQueue[head].model = model;
+  pwmQueue[head].gain = gain;
+  PWM_STORE_RELEASE(&pwmQueueHead, (head + 1) % PWM_QUEUESIZE);
+  return 1;
+}
+
+static void pwm_applyQueue(void) {
+  const int head = PWM_LOAD_ACQUIRE(&pwmQueueHead);
+  int tail = pwmQueueTail;
+  if (tail == head) return;
+  for (; tail != head; tail = (tail + 1) % PWM_QUEUESIZE)
+    pwm_setModel(pwmQueue[tail].group, pwmQueue[tail].first, pwmQueue[tail].count,
+                 pwmQueue[tail].model, pwmQueue[tail].gain);
+  PWM_STORE_RELEASE(&pwmQueueTail, tail);
+}
+
+static void pwm_integrate(int group) {
+  float * const level = pwmlocals[group].level;
+  const float * const in = pwmlocals[group].in;
+  const float * const gain = pwmlocals[group].gain;
+  const float * const rise = pwmlocals[group].rise;
+  const float * const fall = pwmlocals[group].fall;
+  const double now = timer_get_time();
+  const double dt = now - pwmlocals[group].lastTime;
+  int count, ii;
+
+  pwm_applyQueue();
+  count = pwmlocals[group].count;
+  if (pwmlocals[group].lastTime < 0.0 || dt <= 0.0) { /* first sample or time went backwards (state load) */
+    pwmlocals[group].lastTime = now;
+    return;
+  }
+  pwmlocals[group].lastTime = now;
+
+  /*-- the strobe rate is fixed, so this only happens after a reset or model change --*/
+  if (fabs(dt - pwmlocals[group].dt) > pwmlocals[group].dt * 0.01) {
+    float modelRise[CORE_PWM_MODELS], modelFall[CORE_PWM_MODELS];
+    for (ii = 0; ii < CORE_PWM_MODELS; ii++) {
+      modelRise[ii] = (float)(1.0 - exp(-dt / pwmModels[ii].riseTime));
+      modelFall[ii] = (float)(1.0 - exp(-dt / pwmModels[ii].fallTime));
+    }
+    for (ii = 0; ii < count; ii++) {
+      pwmlocals[group].rise[ii] = modelRise[pwmlocals[group].model[ii]];
+      pwmlocals[group].fall[ii] = modelFall[pwmlocals[group].model[ii]];
+    }
+    pwmlocals[group].dt = dt;
+  }
+
+  for (ii = 0; ii < count; ii++) {
+    const float drive = in[ii] * gain[ii];
+    const float k = (drive > level[ii]) ? rise[ii] : fall[ii];
+    level[ii] += (drive - level[ii]) * k;
+  }
+  for (ii = 0; ii < count; ii++) {
+    const float l = (level[ii] < 1.0f) ? level[ii] : 1.0f;
+    pwmlocals[group].out[ii] = (UINT16)(l * 65535.0f + 0.5f);
+  }
+}
+
+/*-- bits are packed 8 outputs per byte, LSB first (like the lamp matrix) --*/
+void core_pwm_sampleBits(int group, const UINT8 *bits) {
+  float * const in = pwmlocals[group].in;
+  int ii;
+  for (ii = 0; ii < pwmlocals[group].count; ii++)
+    in[ii] = (float)((bits[ii >> 3] >> (ii & 7)) & 1);
+  pwm_integrate(group);
+}
+
+/*-- levels are the drive duty cycles (0..1) since the last sample --*/
+void core_pwm_sampleLevels(int group, const float *levels) {
+  memcpy(pwmlocals[group].in, levels, pwmlocals[group].count * sizeof(float));
+  pwm_integrate(group);
+}
+
+int core_pwm_getCount(int group) {
+  return (group < 0 || group >= CORE_PWM_GROUPS) ? 0 : pwmlocals[group].count;
+}
+
+int core_pwm_get16(int group, int first, int count, UINT16 *buffer) {
+  int ii;
+  if (group < 0 || group >= CORE_PWM_GROUPS || first < 0) return 0;
+  if (first + count > pwmlocals[group].count) count = pwmlocals[group].count - first;
+  for (ii = 0; ii < count; ii++)
+    buffer[ii] = pwmlocals[group].out[first + ii];
+  return count > 0 ? count : 0;
+}
+
+int core_pwm_get8(int group, int first, int count, UINT8 *buffer) {
+  int ii;
+  if (group < 0 || group >= CORE_PWM_GROUPS || first < 0) return 0;
+  if (first + count > pwmlocals[group].count) count = pwmlocals[group].count - first;
+  for (ii = 0; ii < count; ii++)
+    buffer[ii] = pwmlocals[group].out[first + ii] >> 8;
+  return count > 0 ? count : 0;
+}
+
 /*----------------------
 /  Initialize PinMAME
 /-----------------------*/
@@ -1780,7 +2015,13 @@ static MACHINE_INIT(core) {
     memset(&coreGlobals, 0, sizeof(coreGlobals));
     memset(&locals, 0, sizeof(locals));
     memset(&locals.lastSeg, -1, sizeof(locals.lastSeg));
+    memset(&pwmlocals, 0, sizeof(pwmlocals)); /* no groups until the driver sets them up */
+    pwmQueueTail = pwmQueueHead; /* drop model changes left from the previous game */
     coreData = (struct pinMachine *)&Machine->drv->pinmame;
+    locals.dmdShade16 = (core_gameData->gen == GEN_SAM) ||
+      // extended handling also for some GTS3 games (SMB, SMBMW and CBW):
+      (strncasecmp(Machine->gamedrv->name, "smb", 3) == 0) || (strncasecmp(Machine->gamedrv->name, "cueball", 7) == 0) ||
+      (core_gameData->gen == GEN_ALVG_DMD2);
     //-- initialise timers --
     if (coreData->timers[0].callback) {
       int ii;
@@ -1864,6 +2105,7 @@ static MACHINE_INIT(core) {
     if (coreData->init) coreData->init();
     /*-- init sound commander --*/
     snd_cmd_init();
+    dmdrec_start(Machine->gamedrv->name);
   }
   /*-- now reset everything --*/
   if (coreData->reset) coreData->reset();
@@ -1897,6 +2139,7 @@ static MACHINE_STOP(core) {
   currbuffer = buffer1;
   oldbuffer = NULL;
   raw_dmdoffs = 0;
+  memset(g_raw_dmd_dirtyrows, 1, sizeof(g_raw_dmd_dirtyrows));
 
   g_raw_gtswpc_dmdframes = 0;
 
@@ -1906,6 +2149,7 @@ static MACHINE_STOP(core) {
   mech_emuExit();
   if (coreData->stop) coreData->stop();
   snd_cmd_exit();
+  dmdrec_stop();
   for (ii = 0; ii < 5; ii++) {
     if (locals.timers[ii])
       timer_remove(locals.timers[ii]);
@@ -2036,8 +2280,15 @@ UINT8 core_calc_modulated_light(UINT32 bits, UINT32 bit_count, volatile UINT8 *p
 }
 
 void core_sound_throttle_adj(int sIn, int *sOut, int buffersize, double samplerate)
+{
+	core_sound_throttle_adj_target(sIn, sOut, buffersize, samplerate, 20.);
+}
+
+/*-- same as above, but keeps the buffered audio around target_ms instead of the fixed 20-25ms --*/
+void core_sound_throttle_adj_target(int sIn, int *sOut, int buffersize, double samplerate, double target_ms)
 {
 	int delta;
+	const double target = samplerate * target_ms / 1000;
 
 	if (sIn >= *sOut)
 		delta = sIn - *sOut;
@@ -2055,29 +2306,29 @@ void core_sound_throttle_adj(int sIn, int *sOut, int buffersize, double samplera
 	}
 #endif
 
-	if (delta > samplerate * 50 / 1000)
+	if (delta > target * 2.5)
 	{
-		// Over 50ms delta and throttle didn't catch it fast enough.   Drop some samples, but not so
+		// Over 2.5x target delta and throttle didn't catch it fast enough.   Drop some samples, but not so
 		// much that we have to restart from a zero buffer.
-		*sOut = sIn - (int)(samplerate * 20 / 1000 + 0.5);
+		*sOut = sIn - (int)(target + 0.5);
 		if (*sOut < 0)
 			*sOut += buffersize;
 
 		SetThrottleAdj(0);
 	}
-	else if (delta > samplerate * 35 / 1000)
+	else if (delta > target * 1.75)
 	{
 		SetThrottleAdj(-4);
 	}
-	else if (delta > samplerate * 25 / 1000)
+	else if (delta > target * 1.25)
 	{
 		SetThrottleAdj(-1);
 	}
-	else if (delta < samplerate * 10 / 1000)
+	else if (delta < target * 0.5)
 	{
 		SetThrottleAdj(10);
 	}
-	else if (delta < samplerate * 20 / 1000)
+	else if (delta < target)
 	{
 		SetThrottleAdj(2);
 	}
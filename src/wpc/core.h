@@ -491,7 +491,27 @@ INLINE void core_update_modulated_light(UINT32 *light, int bit){
 }
 
 extern UINT8 core_calc_modulated_light(UINT32 bits, UINT32 bit_count, volatile UINT8 *prev_level);
+/*-- sub-frame output integrator --*/
+#define CORE_PWM_LAMPS     0   /* lamp matrix, output = col*8+row */
+#define CORE_PWM_SOLS      1   /* solenoids, output = solNo-1 */
+#define CORE_PWM_GI        2   /* GI strings */
+#define CORE_PWM_GROUPS    3
+#define CORE_PWM_MAXOUT    (CORE_MAXLAMPCOL*8)
+
+#define CORE_PWM_BULB      0   /* #44/#555 incandescent lamp and GI bulbs */
+#define CORE_PWM_FLASHER   1   /* #906 incandescent flasher bulbs */
+#define CORE_PWM_LED       2   /* LED replacement bulbs */
+#define CORE_PWM_MODELS    3
+
+extern void core_pwm_init(int group, int count, int model, float gain);
+extern int  core_pwm_setModel(int group, int first, int count, int model, float gain);
+extern void core_pwm_sampleBits(int group, const UINT8 *bits);
+extern void core_pwm_sampleLevels(int group, const float *levels);
+extern int  core_pwm_getCount(int group);
+extern int  core_pwm_get8(int group, int first, int count, UINT8 *buffer);
+extern int  core_pwm_get16(int group, int first, int count, UINT16 *buffer);
 extern void core_sound_throttle_adj(int sIn, int *sOut, int buffersize, double samplerate);
+extern void core_sound_throttle_adj_target(int sIn, int *sOut, int buffersize, double samplerate, double target_ms);
 
 /*-- nvram handling --*/
 extern void core_nvram(void *file, int write, void *mem, size_t length, UINT8 init);
@@ -5,6 +5,7 @@
 #include "core.h"
 #include "sndbrd.h"
 #include "dedmd.h"
+#include "dmdrec.h"
 #ifdef PROC_SUPPORT
 #include "p-roc/p-roc.h"
 #endif
@@ -131,6 +132,8 @@ static READ_HANDLER(dmd32_latch_r) {
 }
 
 static INTERRUPT_GEN(dmd32_firq) {
+  /*-- the refresh shows the 2 planes of the visible page, the 1st one twice as long (see dedmd32_update) --*/
+  dmdrec_subFrame(0, 128, 32, 1, 2, DMDREC_WEIGHTS(2,1,0,0), dmd32RAM + ((crtc6845_start_address_r(0) & 0x0100)<<2), 0x200, DMDREC_MSBFIRST);
   cpu_set_irq_line(dmdlocals.brdData.cpuNo, M6809_FIRQ_LINE, HOLD_LINE);
 }
 
@@ -255,6 +258,7 @@ static READ16_HANDLER(dmd64_latch_r) {
   return dmdlocals.cmd;
 }
 static INTERRUPT_GEN(dmd64_irq2) {
+  dmdrec_subFrame(0, 192, 64, 1, 2, DMDREC_WEIGHTS(2,1,0,0), (UINT8 *)dmd64RAM + ((crtc6845_start_address_r(0) & 0x400)<<2), 0x800, DMDREC_WORD16);
   cpu_set_irq_line(dmdlocals.brdData.cpuNo, MC68000_IRQ_2, HOLD_LINE);
 }
 static WRITE16_HANDLER(crtc6845_msb_address_w)  { if (ACCESSING_MSB) crtc6845_address_0_w(offset,data>>8);  }
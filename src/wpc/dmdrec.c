@@ -0,0 +1,303 @@
+// license:BSD-3-Clause
+
+/***************************************************************************
+ DMD sub-frame recorder
+
+ Records every sub-frame the DMD hardware displays (the bitplanes latched
+ at each display refresh, which the drivers average into the shades of a
+ frame) with its emulated time, e.g. for colourisation tools. The emulation
+ thread only copies the planes into a ring buffer, a writer thread converts
+ them into the file format below, compresses and appends them.
+
+ The file is a sequence of chunks, all values little endian:
+   char   magic[4]  "PMDR"
+   UINT8  version   2
+   UINT8  type      1 = session, 2 = sub-frames
+   UINT16 reserved
+   UINT32 size      of the data following the chunk header
+   UINT32 rawSize   of the data after inflating it (= size for sessions)
+ A session chunk starts each recording and holds the game name (zero
+ terminated), the times of the following sub-frames count from its start.
+ The sub-frame chunks are zlib compressed (compress2/uncompress) and hold
+ the sub-frames of about one emulated second, each as
+   UINT64 time      emulated time in microseconds
+   UINT8  display   0, or 1 for the second DMD of Strikes N' Spares
+   UINT8  planes
+   UINT8  bpp       1 for bitplanes, 4 for SAM frames (already in shades)
+   UINT8  weights   2 bits per plane (plane 0 in the lowest bits): how much it counts
+                    towards the shade of a dot, i.e. the shade of a refresh is
+                    sum(weight*dot) / sum(weight); 0 for bpp 4
+   UINT16 width, height
+   planes*height rows of width*bpp/8 bytes, leftmost pixel in the lowest bit(s)
+ Every chunk can be read without the ones after it, so new recordings are
+ simply appended and a file cut short by a crash only loses the last chunk.
+ Version 1 files had no weights (always 0).
+
+ Sub-frames per platform, only the planes the board displays are recorded:
+   WPC           1 plane per refresh (122Hz)
+   GTS3          1 plane per refresh (per display)
+   DE/SE 128x32  2 planes per refresh, weights 2:1 (78Hz)
+   DE 192x64     2 planes per refresh, weights 2:1 (75Hz)
+   Alvin G       2 planes per refresh, weights 1:2 (World Tour)
+   Alvin G DMD2  4 planes per refresh, weights 1:1:1:1 (Pistol Poker, Mystery Castle)
+                 Both Alvin G boards show 1 plane if the planes are disabled.
+   SAM           1 frame of 16 shades per video frame, as the hardware shades aren't emulated as sub-frames
+ ***************************************************************************/
+#include <zlib.h>
+#include "driver.h"
+#include "core.h"
+#include "dmdrec.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+ #include <windows.h>
+ #include <process.h>
+ #define DMDREC_LOCK()   EnterCriticalSection(&locals.lock)
+ #define DMDREC_UNLOCK() LeaveCriticalSection(&locals.lock)
+ #define DMDREC_SLEEP()  Sleep(10)
+#else
+ #include <pthread.h>
+ #include <unistd.h>
+ #define DMDREC_LOCK()   pthread_mutex_lock(&locals.lock)
+ #define DMDREC_UNLOCK() pthread_mutex_unlock(&locals.lock)
+ #define DMDREC_SLEEP()  usleep(10000)
+#endif
+
+#define DMDREC_SLOTS     1024    /* sub-frames buffered between the emulation and the writer thread */
+#define DMDREC_MAXDATA   0xc00   /* 2 planes of 192x64 */
+#define DMDREC_BLOCKSIZE 0x40000 /* flush a chunk at this raw size, or after one emulated second */
+#define DMDREC_HEADERSIZE 16
+#define DMDREC_RECHEADER  16
+
+typedef struct {
+  double time;
+  int display, width, height, bpp, planes, weights, flags;
+  UINT8 data[DMDREC_MAXDATA];
+} tSubFrame;
+
+static struct {
+  tSubFrame *ring;
+  volatile UINT32 head, tail; /* written by the emulation/writer thread, under lock */
+  volatile int stop;
+  UINT32 dropped;             /* emulation thread only */
+  FILE *file;
+  int writeError;
+  UINT8 *block, *packed;
+  UINT32 blockSize;
+  double blockTime;
+#if defined(_WIN32) || defined(_WIN64)
+  CRITICAL_SECTION lock;
+  HANDLE thread;
+#else
+  pthread_mutex_t lock;
+  pthread_t thread;
+#endif
+} locals;
+
+static const UINT8 reverseNibble[16] = {
+  0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe,
+  0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf
+};
+
+INLINE UINT8 reverse(UINT8 n) {
+  return (reverseNibble[n & 0x0f] << 4) | reverseNibble[n >> 4];
+}
+
+static void put16(UINT8 *p, UINT32 v) { p[0] = (UINT8)v; p[1] = (UINT8)(v >> 8); }
+static void put32(UINT8 *p, UINT32 v) { put16(p, v); put16(p+2, v >> 16); }
+
+/*-- writer thread --*/
+static void writeChunk(int type, const UINT8 *data, UINT32 size, UINT32 rawSize) {
+  UINT8 header[DMDREC_HEADERSIZE];
+
+  memcpy(header, "PMDR", 4);
+  header[4] = 2; header[5] = type; put16(header+6, 0);
+  put32(header+8, size); put32(header+12, rawSize);
+  if (!locals.writeError &&
+      (fwrite(header, 1, sizeof(header), locals.file) != sizeof(header) ||
+       fwrite(data, 1, size, locals.file) != size))
+    locals.writeError = 1;
+}
+
+static void flushBlock(void) {
+  uLongf size = compressBound(locals.blockSize);
+
+  if (locals.blockSize == 0)
+    return;
+  if (compress2(locals.packed, &size, locals.block, locals.blockSize, Z_DEFAULT_COMPRESSION) == Z_OK)
+    writeChunk(2, locals.packed, (UINT32)size, locals.blockSize);
+  else
+    locals.writeError = 1;
+  fflush(locals.file);
+  locals.blockSize = 0;
+}
+
+/* append a sub-frame to the current chunk, with the pixels in file order */
+static void addSubFrame(const tSubFrame *sf) {
+  const int rowBytes = sf->width * sf->bpp / 8;
+  const int size = sf->planes * sf->height * rowBytes;
+  const UINT64 time = (UINT64)(sf->time * 1e6 + 0.5);
+  UINT8 *out;
+  int ii;
+
+  if (locals.blockSize > 0 && (locals.blockSize + DMDREC_RECHEADER + size > DMDREC_BLOCKSIZE || sf->time >= locals.blockTime + 1.0))
+    flushBlock();
+  if (locals.blockSize == 0)
+    locals.blockTime = sf->time;
+
+  out = locals.block + locals.blockSize;
+  put32(out, (UINT32)time); put32(out+4, (UINT32)(time >> 32));
+  out[8] = sf->display; out[9] = sf->planes; out[10] = sf->bpp; out[11] = sf->weights;
+  put16(out+12, sf->width); put16(out+14, sf->height);
+  out += DMDREC_RECHEADER;
+
+  if (sf->flags & DMDREC_WORD16) {
+    const UINT16 *in = (const UINT16 *)sf->data;
+    for (ii = 0; ii < size/2; ii++) {
+      *out++ = reverse((UINT8)(in[ii] >> 8));
+      *out++ = reverse((UINT8)in[ii]);
+    }
+  }
+  else if (sf->flags & DMDREC_MSBFIRST) {
+    for (ii = 0; ii < size; ii++)
+      *out++ = reverse(sf->data[ii]);
+  }
+  else
+    memcpy(out, sf->data, size);
+  locals.blockSize += DMDREC_RECHEADER + size;
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+static unsigned __stdcall writerThread(void *param) {
+#else
+static void *writerThread(void *param) {
+#endif
+  UINT32 tail = locals.tail;
+
+  for (;;) {
+    UINT32 head;
+    int stop;
+
+    DMDREC_LOCK();
+    head = locals.head;
+    stop = locals.stop;
+    DMDREC_UNLOCK();
+
+    if (tail != head) {
+      for (; tail != head; tail++)
+        addSubFrame(&locals.ring[tail % DMDREC_SLOTS]);
+      DMDREC_LOCK();
+      locals.tail = tail;
+      DMDREC_UNLOCK();
+    }
+    else if (stop)
+      break;
+    else
+      DMDREC_SLEEP();
+  }
+  flushBlock();
+  return 0;
+}
+
+/*-- emulation thread --*/
+static void freeRecording(void) {
+  fclose(locals.file); locals.file = NULL;
+  free(locals.ring); free(locals.block); free(locals.packed);
+  locals.ring = NULL; locals.block = locals.packed = NULL;
+}
+
+void dmdrec_start(const char *gameName) {
+  int started;
+
+  if (locals.ring || !options.dmd_record || !options.dmd_record[0])
+    return;
+
+  locals.file = fopen(options.dmd_record, "ab");
+  if (locals.file == NULL) {
+    logerror("Could not open the DMD recording %s\n", options.dmd_record);
+    return;
+  }
+  locals.ring   = malloc(DMDREC_SLOTS * sizeof(tSubFrame));
+  locals.block  = malloc(DMDREC_BLOCKSIZE);
+  locals.packed = malloc(compressBound(DMDREC_BLOCKSIZE));
+  if (!locals.ring || !locals.block || !locals.packed)
+    { freeRecording(); return; }
+  locals.head = locals.tail = 0;
+  locals.stop = 0;
+  locals.dropped = 0;
+  locals.writeError = 0;
+  locals.blockSize = 0;
+
+  /* the session chunk is written before the thread starts */
+  writeChunk(1, (const UINT8 *)gameName, (UINT32)strlen(gameName)+1, (UINT32)strlen(gameName)+1);
+
+#if defined(_WIN32) || defined(_WIN64)
+  InitializeCriticalSection(&locals.lock);
+  locals.thread = (HANDLE)_beginthreadex(NULL, 0, writerThread, NULL, 0, NULL);
+  started = (locals.thread != 0);
+  if (!started) DeleteCriticalSection(&locals.lock);
+#else
+  pthread_mutex_init(&locals.lock, NULL);
+  started = (pthread_create(&locals.thread, NULL, writerThread, NULL) == 0);
+  if (!started) pthread_mutex_destroy(&locals.lock);
+#endif
+  if (!started)
+    freeRecording();
+}
+
+void dmdrec_stop(void) {
+  if (!locals.ring)
+    return;
+
+  DMDREC_LOCK();
+  locals.stop = 1;
+  DMDREC_UNLOCK();
+#if defined(_WIN32) || defined(_WIN64)
+  WaitForSingleObject(locals.thread, INFINITE);
+  CloseHandle(locals.thread);
+  DeleteCriticalSection(&locals.lock);
+#else
+  pthread_join(locals.thread, NULL);
+  pthread_mutex_destroy(&locals.lock);
+#endif
+
+  if (locals.writeError)
+    logerror("Could not write the DMD recording %s\n", options.dmd_record);
+  if (locals.dropped)
+    logerror("DMD recording: %u sub-frames dropped, the writer thread didn't keep up\n", locals.dropped);
+  freeRecording();
+}
+
+int dmdrec_isRecording(void) {
+  return locals.ring != NULL;
+}
+
+void dmdrec_subFrame(int display, int width, int height, int bpp, int planes, int weights, const UINT8 *data, int planeStride, int flags) {
+  const int size = width * height * bpp / 8;
+  tSubFrame *sf;
+  UINT32 head, tail;
+  int ii;
+
+  if (!locals.ring || planes * size > DMDREC_MAXDATA)
+    return;
+
+  DMDREC_LOCK();
+  head = locals.head;
+  tail = locals.tail;
+  DMDREC_UNLOCK();
+  /*-- never wait for the writer, rather lose the sub-frame --*/
+  if (head - tail >= DMDREC_SLOTS) {
+    locals.dropped++;
+    return;
+  }
+
+  sf = &locals.ring[head % DMDREC_SLOTS];
+  sf->time = timer_get_time();
+  sf->display = display; sf->width = width; sf->height = height;
+  sf->bpp = bpp; sf->planes = planes; sf->weights = weights; sf->flags = flags;
+  for (ii = 0; ii < planes; ii++)
+    memcpy(sf->data + ii*size, data + ii*planeStride, size);
+
+  DMDREC_LOCK();
+  locals.head = head + 1;
+  DMDREC_UNLOCK();
+}
@@ -0,0 +1,24 @@
+// license:BSD-3-Clause
+
+#ifndef INC_DMDREC
+#define INC_DMDREC
+#if !defined(__GNUC__) || (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || (__GNUC__ >= 4)	// GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+/*-- flags for dmdrec_subFrame, describing the pixel order of the passed planes --*/
+#define DMDREC_MSBFIRST 0x01 /* leftmost pixel in bit 7 of each byte (default: bit 0) */
+#define DMDREC_WORD16   0x02 /* 16 bit words in host byte order, leftmost pixel in bit 15 */
+
+/*-- how much each of the (up to 4) planes of a sub-frame counts towards the shade of a dot, 0..3 --*/
+#define DMDREC_WEIGHTS(w0,w1,w2,w3) ((w0) | ((w1)<<2) | ((w2)<<4) | ((w3)<<6))
+
+/* Exported Functions */
+void dmdrec_start(const char *gameName);
+void dmdrec_stop(void);
+int  dmdrec_isRecording(void);
+/* record a sub-frame as displayed from now on: planes bitplanes (or one 4 bit frame for bpp = 4)
+   of width*height pixels each, planeStride bytes apart, weighted as given by DMDREC_WEIGHTS (0 for bpp = 4) */
+void dmdrec_subFrame(int display, int width, int height, int bpp, int planes, int weights, const UINT8 *data, int planeStride, int flags);
+
+#endif /* INC_DMDREC */
@@ -25,6 +25,7 @@
 #include "gts3.h"
 #include "vidhrdw/crtc6845.h"
 #include "gts3dmd.h"
+#include "dmdrec.h"
 #include "gts80s.h"
 
 UINT8 DMDFrames [GTS3DMD_FRAMES_5C][0x200];
@@ -843,6 +844,7 @@ static void dmd_vblank(int which) {
 		memcpy(DMDFrames2[GTS3_dmdlocals[1].nextDMDFrame],memory_region(GTS3_MEMREG_DCPU2)+0x1000+offset,0x200);
 	else
 		memcpy(DMDFrames[GTS3_dmdlocals[0].nextDMDFrame],memory_region(GTS3_MEMREG_DCPU1)+0x1000+offset,0x200);
+	dmdrec_subFrame(which, 128, 32, 1, 1, DMDREC_WEIGHTS(1,0,0,0), which ? DMDFrames2[GTS3_dmdlocals[1].nextDMDFrame] : DMDFrames[GTS3_dmdlocals[0].nextDMDFrame], 0x200, DMDREC_MSBFIRST);
 	cpu_set_nmi_line(which ? GTS3_DCPUNO2 : GTS3_DCPUNO, PULSE_LINE);
 	GTS3_dmdlocals[which].nextDMDFrame = (GTS3_dmdlocals[which].nextDMDFrame + 1) % (GTS3_dmdlocals[0].color_mode == 0 ? GTS3DMD_FRAMES_4C_a : (GTS3_dmdlocals[0].color_mode == 1 ? GTS3DMD_FRAMES_4C_b : GTS3DMD_FRAMES_5C));
 }
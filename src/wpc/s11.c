@@ -759,6 +759,8 @@ static MACHINE_INIT(s11) {
   pia_config(S11_PIA3, PIA_STANDARD_ORDERING, &s11_pia[3]);
   pia_config(S11_PIA4, PIA_STANDARD_ORDERING, &s11_pia[4]);
   pia_config(S11_PIA5, PIA_STANDARD_ORDERING, &s11_pia[5]);
+  /* the main RAM is only written by the main CPU (0), so its idle loops can be skipped */
+  m6800_set_idle_skip(0, pmoptions.idle_skip);
 
   /*Additional hardware dependent init code*/
   switch (core_gameData->gen) {
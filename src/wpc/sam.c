@@ -39,6 +39,7 @@
 #include "sndbrd.h"
 #include "dmddevice.h"
 #include "mech.h"
+#include "dmdrec.h"
 
 // Defines
 
@@ -725,6 +726,33 @@ A3 A2 A1 A0 (When IOSTB = 0)
  Row 9 - From Aux Lamp Strobe Line, Data Bit 1
 ---------------------------------------------------------------------------------------------*/
 
+/*----------------------------------------------------
+/  Sample the outputs for the sub-frame integrator.
+/  Called before the next lamp column is selected, so
+/  this is the state driven since the previous column
+/-----------------------------------------------------*/
+static void sam_pwm_sample(void)
+{
+	UINT8 lamps[8], sols[8];
+	float gi[CORE_MAXGI];
+	int ii;
+
+	memset(lamps, 0, sizeof(lamps));
+	if (samlocals.lampcol < 8)
+		lamps[samlocals.lampcol] = coreGlobals.tmpLampMatrix[samlocals.lampcol];
+	core_pwm_sampleBits(CORE_PWM_LAMPS, lamps);
+
+	/*-- the last state written to each driver, same numbering as sam_getSol() --*/
+	memset(sols, 0, sizeof(sols));
+	for (ii = 0; ii < 64; ii++)
+		sols[ii >> 3] |= (samlocals.solenoidbits[ii] & 1) << (ii & 7);
+	core_pwm_sampleBits(CORE_PWM_SOLS, sols);
+
+	for (ii = 0; ii < CORE_MAXGI; ii++)
+		gi[ii] = coreGlobals.gi[ii] ? 1.0f : 0.0f;
+	core_pwm_sampleLevels(CORE_PWM_GI, gi);
+}
+
 static WRITE32_HANDLER(sambank_w)
 {
 	// with the current technique, a maximum of 14 displayed rows is possible (WPT only uses 10),
@@ -955,6 +983,8 @@ static WRITE32_HANDLER(sambank_w)
 			case 0x02400028:
 				memset(samlocals.dataWrites, 0, sizeof(samlocals.dataWrites));
 				samlocals.colWrites++;
+				if (samlocals.colWrites == 1)
+					sam_pwm_sample();
 				if(samlocals.colWrites == 1 || samlocals.colWrites == 2) //!! just the 2 case ??
 				{
 					samlocals.lampcol = core_BitColToNum(data);
@@ -1216,6 +1246,11 @@ static MACHINE_INIT(sam) {
 	at91_set_ram_pointers(sam_reset_ram, sam_page0_ram);
 	at91_set_transmit_serial(sam_transmit_serial);
 	at91_set_serial_receive_ready(sam_LED_hack);
+
+	/*-- sub-frame outputs, the lamp matrix is strobed one of 8 columns at a time --*/
+	core_pwm_init(CORE_PWM_LAMPS, 64, CORE_PWM_BULB, 8.0f);
+	core_pwm_init(CORE_PWM_SOLS, 64, CORE_PWM_FLASHER, 1.0f);
+	core_pwm_init(CORE_PWM_GI, 1, CORE_PWM_BULB, 1.0f);
 #ifdef SAM_USE_JIT
 	if (options.at91jit)
 	{
@@ -1619,6 +1654,8 @@ MACHINE_DRIVER_END
 static PINMAME_VIDEO_UPDATE(samdmd_update) {
 	//static const UINT8 hew[16] = { 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15, 15};
 
+	UINT8 frame[32*128/2]; // the shades aren't emulated as sub-frames, so the mixed frame gets recorded, 2 pixels per byte
+	const int record = dmdrec_isRecording();
 	int ii;
 	for( ii = 0; ii < 32; ii++ )
 	{
@@ -1636,8 +1673,12 @@ static PINMAME_VIDEO_UPDATE(samdmd_update) {
 				LOG(("Special DMD Bitmask %01X",mix));
 			*line = /*hew[*/temp/*]*/;
 			line++;
+			if (record)
+				frame[(ii*128 + jj)/2] = (jj & 1) ? (frame[(ii*128 + jj)/2] | (temp << 4)) : temp;
 		}
 	}
+	if (record)
+		dmdrec_subFrame(0, 128, 32, 4, 1, 0, frame, sizeof(frame), 0);
 
 	video_update_core_dmd(bitmap, cliprect, layout);
 	return 0;
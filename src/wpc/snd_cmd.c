@@ -27,6 +27,10 @@
  //#define VPINMAME_PINSOUND // pmoptions.sound_mode == 2 || 3
 #endif
 
+#if defined(PINMAME_DLL) || defined(LIBPINMAME)
+ extern void OnSoundCommand(int boardNo, int cmd);
+#endif
+
 #define VERBOSE 0
 
 #if VERBOSE
@@ -512,6 +516,9 @@ void snd_cmd_log(int boardNo, int cmd) {
   if (options.samplerate != 0 && (pmoptions.sound_mode == 2 || pmoptions.sound_mode == 3))
     pinsound_handle(boardNo, cmd);
 #endif
+#if defined(PINMAME_DLL) || defined(LIBPINMAME)
+  OnSoundCommand(boardNo, cmd);
+#endif
 
   if (locals.soundMode || (locals.boards == 0)) return; // Don't log from within sound commander
   if (locals.boards == 3) {
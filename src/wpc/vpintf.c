@@ -48,6 +48,11 @@ int vp_getChangedLamps(vp_tChgLamps chgStat) {
   memcpy(lampMatrix, coreGlobals.lampMatrix, sizeof(lampMatrix));
   memcpy(RGBlamps, coreGlobals.RGBlamps, sizeof(RGBlamps));
 
+  /*-- nothing changed (the common case), skip the per lamp scan --*/
+  if (memcmp(lampMatrix, locals.lastLampMatrix, sizeof(lampMatrix)) == 0 &&
+      memcmp(RGBlamps, locals.lastRGBLamps, sizeof(RGBlamps)) == 0)
+    return 0;
+
   /*-- fill in array --*/
   for (ii = 0; ii < CORE_STDLAMPCOLS+core_gameData->hw.lampCol; ii++) {
     int chgLamp = lampMatrix[ii] ^ locals.lastLampMatrix[ii];
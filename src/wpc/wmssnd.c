@@ -1102,6 +1102,10 @@ static int dcs_custStart(const struct MachineSound *msound);
 static void dcs_custStop(void);
 static void dcs_dacUpdate(int num, INT16 *buffer, int length);
 static void dcs_txData(UINT16 start, UINT16 size, UINT16 memStep, double sRate);
+#ifdef WPCDCSSPEEDUP
+static void dcs_cacheInit(int enable);
+static void dcs_cacheExit(void);
+#endif /* WPCDCSSPEEDUP */
 
 /*-- external interface --*/
 static READ_HANDLER(dcs_data_r);
@@ -1341,6 +1345,9 @@ static int dcs_custStart(const struct MachineSound *msound) {
 #endif
 #endif
 
+#ifdef WPCDCSSPEEDUP
+  dcs_cacheInit(pmoptions.dcs_cache);
+#endif /* WPCDCSSPEEDUP */
   return (dcs_dac.buffer == 0);
 }
 
@@ -1354,6 +1361,9 @@ static void dcs_custStop(void) {
  #endif
 #endif
     }
+#ifdef WPCDCSSPEEDUP
+  dcs_cacheExit();
+#endif /* WPCDCSSPEEDUP */
 }
 
 
@@ -1690,6 +1700,136 @@ static void adsp_txCallback(int port, INT32 data) {
 }
 
 #ifdef WPCDCSSPEEDUP
+/*
+ *   Helpers shared by both speedup variants.
+ *
+ *   The loops are written over plain arrays with independent iterations,
+ *   so that the compiler can vectorise them. They produce exactly the same
+ *   samples as the emulated code.
+ */
+
+/* MR = MR +/- (MX * MY) (RND), tmp is the product that was added or subtracted */
+#define DCS_RND(mr, tmp) \
+  ((INT32)(((mr) + 0x8000) & ((((tmp) & 0xffff) == 0x8000) ? 0xfffeffff : 0xffffffff)))
+
+/*
+ *   The radix-2 butterfly passes of the decoder (the triple loop of the ROM
+ *   code). Each pass splits x into groups of 2*span words; the first span
+ *   words of a group are combined with the second span words, rotated by the
+ *   group's twiddle factor tw[group] (MY0) / tw[twIm + group] (MY1). The
+ *   next pass has twice the groups with half the span.
+ *
+ *   The ROM code walks I0/I1/I2 through the group, but as every iteration
+ *   reads and writes only its own two words of each half, the loop is the
+ *   same as this indexed one.
+ */
+static void dcs_butterflies(INT16 *x, const INT16 *tw, int twIm, int groups, int span, int passes) {
+  for (; passes > 0; passes--, groups <<= 1, span >>= 1) {
+    int jj, kk;
+    for (jj = 0; jj < groups; jj++) {
+      INT16 * const a = x + 2*jj*span; /* I0 */
+      INT16 * const b = a + span;      /* I1 = I2 */
+      const INT32 my0 = tw[jj], my1 = tw[twIm + jj];
+      for (kk = 0; kk < span; kk += 2) {
+        const INT32 mx0 = b[kk], mx1 = b[kk+1];
+        const INT32 ay0 = a[kk], ay1 = a[kk+1];
+        INT32 tmp, ax0, mr1;
+        /* MR = MX0 * MY0 (SS); MR = MR - MX1 * MY1 (RND); AX0 = MR1 */
+        tmp = (mx1 * my1)<<1;
+        ax0 = DCS_RND(((mx0 * my0)<<1) - tmp, tmp) >> 16;
+        /* MR = MX1 * MY0 (SS); MR = MR + MX0 * MY1 (RND) */
+        tmp = (mx0 * my1)<<1;
+        mr1 = DCS_RND(((mx1 * my0)<<1) + tmp, tmp) >> 16;
+        a[kk]   = ay0 - ax0;
+        b[kk]   = ax0 + ay0;
+        a[kk+1] = ay1 - mr1;
+        b[kk+1] = mr1 + ay1;
+      }
+    }
+  }
+}
+
+/*
+ *   Optional cache of decoded frames (-dcs_cache). The ROM code decodes
+ *   the compressed stream into a frame of frequency data, which the native
+ *   routines above turn into 0x100 samples. DCS games play the same effects
+ *   and music cues over and over, so the same frames come up again and
+ *   again; for those the cache returns the samples of the first run.
+ *   A hit needs the same frame data, volume and twiddle factors, so the
+ *   output is exactly the same as without the cache.
+ */
+#define DCS_CACHE_SIZE   1024 /* frames, must be a power of 2 */
+#define DCS_CACHE_WORDS  0x200
+
+typedef struct {
+  UINT32 hash;
+  UINT16 volume;
+  UINT16 used;
+  UINT16 in[DCS_CACHE_WORDS];
+  UINT16 out[DCS_CACHE_WORDS];
+} dcs_tCacheFrame;
+
+static struct {
+  dcs_tCacheFrame *frames;
+  dcs_tCacheFrame *pending; /* frame to store the result of the current decode in */
+  int    words;             /* frame size of the running game, 0x100 (1994+) or 0x200 (1993) */
+  INT16  tw[2*0x80];        /* twiddle factors the cached frames were decoded with */
+} dcs_cache;
+
+static void dcs_cacheInit(int enable) {
+  dcs_cache.pending = NULL;
+  dcs_cache.words = 0;
+  if (enable && !dcs_cache.frames)
+    dcs_cache.frames = calloc(DCS_CACHE_SIZE, sizeof(dcs_tCacheFrame));
+}
+
+static void dcs_cacheExit(void) {
+  free(dcs_cache.frames); dcs_cache.frames = NULL;
+  dcs_cache.pending = NULL;
+}
+
+/*-- copy the decoded samples to frame and return TRUE if the frame was decoded before --*/
+static int dcs_cacheGet(UINT16 *frame, int words, UINT16 volume, const INT16 *tw, int twCount) {
+  dcs_tCacheFrame *f;
+  UINT32 hash = 2166136261u ^ volume;
+  int ii;
+
+  dcs_cache.pending = NULL;
+  if (!dcs_cache.frames) return FALSE;
+
+  /*-- the twiddle factors only change with the ROM code, start over then --*/
+  if (words != dcs_cache.words || memcmp(tw, dcs_cache.tw, 2*twCount*sizeof(INT16))) {
+    for (ii = 0; ii < DCS_CACHE_SIZE; ii++)
+      dcs_cache.frames[ii].used = FALSE;
+    dcs_cache.words = words;
+    memcpy(dcs_cache.tw, tw, 2*twCount*sizeof(INT16));
+  }
+  for (ii = 0; ii < words; ii++)
+    hash = (hash ^ frame[ii]) * 16777619u;
+
+  f = &dcs_cache.frames[hash & (DCS_CACHE_SIZE-1)];
+  if (f->used && f->hash == hash && f->volume == volume &&
+      memcmp(f->in, frame, words*sizeof(UINT16)) == 0) {
+    memcpy(frame, f->out, words*sizeof(UINT16));
+    return TRUE;
+  }
+  /*-- replace whatever was cached in this slot --*/
+  f->used = FALSE;
+  f->hash = hash;
+  f->volume = volume;
+  memcpy(f->in, frame, words*sizeof(UINT16));
+  dcs_cache.pending = f;
+  return FALSE;
+}
+
+static void dcs_cachePut(const UINT16 *frame) {
+  if (dcs_cache.pending) {
+    memcpy(dcs_cache.pending->out, frame, dcs_cache.words*sizeof(UINT16));
+    dcs_cache.pending->used = TRUE;
+    dcs_cache.pending = NULL;
+  }
+}
+
 /*
  *   Speedup for DCS games from 1994 and later.
  *   
@@ -1719,6 +1859,7 @@ static void adsp_txCallback(int port, INT32 data) {
  */
 UINT32 dcs_speedup(UINT32 pc) {
   UINT16 *ram1source, *ram2source, volume;
+  INT16 tw[2*0x40];
   int ii;
 
   /* DCS and DCS95 uses different buffers */
@@ -1738,173 +1879,62 @@ UINT32 dcs_speedup(UINT32 pc) {
     volume = ram2source[((volumeOP>>4)&0x3fff)-0x3800];
     /*DBGLOG(("OP=%6x addr=%4x V=%4x\n",volumeOP,(volumeOP>>4)&0x3fff,volume));*/
   }
+  /* the twiddle factors of the butterfly passes: MY0 = DM(I4,M5), MY1 = DM(I5,M5) */
+  for (ii = 0; ii < 0x40; ii++) {
+    tw[ii]        = ram1source[0x0080 + ii]; /* I4 = $1080 >>> (0780) <<< */
+    tw[0x40 + ii] = ram1source[ii];          /* I5 = $1000 >>> (0700) <<< */
+  }
+  if (dcs_cacheGet(ram2source, 0x100, volume, tw, 0x40)) {
+    activecpu_set_reg(ADSP2100_PC, pc + 0x2b89 - 0x2b44);
+    return 0; /* execute a NOP */
+  }
   {
-    UINT16 *i0, *i2;
+    INT16 * const x = (INT16 *)ram2source;
 			/* 2B44     I0 = $2000 >>> (3800) <<< */
-    i0 = &ram2source[0];
 			/* 2B45:    I2 = $2080 >>> (3880) <<< */
-    i2 = &ram2source[0x0080];
 			/* 2B46     M2 = $3FFF */
 			/* 2B47     M3 = $3FFD */
 			/* 2B48     CNTR = $0040 */
 			/* 2B49     DO $2B53 UNTIL CE */
-    /* M0 = 0, M1 = 1, M2 = -1 */
-    for (ii = 0; ii < 0x0040; ii++) {
-      INT16 ax0 , ay0, ax1, ay1, ar;
 			/* 2B4A       AX0 = DM(I0,M1) */
-      ax0 = *i0++;
 			/* 2B4B       AY0 = DM(I2,M0) */
-      ay0 = *i2;
 			/* 2B4C       AR = AX0 + AY0, AX1 = DM(I0,M2) */
-      ax1 = *i0--;
-      ar = ax0 + ay0;
 			/* 2B4D       AR = AX0 - AY0, DM(I0,M1) = AR */
-      *i0++ = ar;
-      ar = ax0 - ay0;
 			/* 2B4E       DM(I2,M1) = AR */
-      *i2++ = ar;
 			/* 2B4F       AY1 = DM(I2,M0) */
-      ay1 = *i2;
 			/* 2B50       AR = AX1 + AY1 */
-      ar = ax1 + ay1;
 			/* 2B51       DM(I0,M1) = AR */
-      *i0++ = ar;
 			/* 2B52       AR = AX1 - AY1 */
-      ar = ax1 - ay1;
   			/* 2B53       DM(I2,M1) = AR */
-      *i2++ = ar;
-    }
-  }
-  {
-    int mem63d, mem63e, mem63f;
-    int jj,kk;
-  			/* 2B54     AR = $0002 */
-			/* 2B55     DM($15EB) = AR (063d) */
-    mem63d = 2;
-			/* 2B56     SI = $0040 */
-			/* 2B57     DM($15ED) = SI (063e) */
-    mem63e = 0x40;
-			/* 2B58     SR = LSHIFT SI BY -1 (LO) */
-			/* 2B59     DM($15EF) = SR0 (063f) */
-    mem63f = mem63e >> 1;
-			/* 2B5A     M0 = $3FFF */
-			/* 2B5B     CNTR = $0006 */
-			/* 2B5C     DO $2B80 UNTIL CE */
-
-    /* M0 = -1, M1 = 1, M5 = 1 */
-    for (ii = 0; ii < 6; ii++) {
-      UINT16 *i0, *i1, *i2, *i4, *i5;
-      INT16 m2, m3;
-			/* 2B5D       I4 = $1080 >>> (0780) <<< */
-      i4 = &ram1source[0x0080];
-			/* 2B5E       I5 = $1000 >>> (0700) <<< */
-      i5 = &ram1source[0x0000];
-			/* 2B5F       I0 = $2000 >>> (3800) <<< */
-      i0 = &ram2source[0x0000];
-			/* 2B60       I1 = $2000 >>> (3800) <<< */
-      i1 = &ram2source[0x0000];
-			/* 2B61       AY0 = DM($15ED) (063e) */
-			/* 2B62       M2 = AY0 */
-      m2 = mem63e;
-			/* 2B63       MODIFY (I1,M2) */
-      i1 += m2;
-			/* 2B64       I2 = I1 */
-      i2 = i1;
-			/* 2B65       AR = AY0 - 1 */
-			/* 2B66       M3 = AR */
-      m3 = mem63e - 1;
-			/* 2B67       CNTR = DM($15EB) (063d) */
-			/* 2B68       DO $2B79 UNTIL CE */
-
-      for (jj = 0; jj < mem63d; jj++) {
-        INT16 mx0, mx1, my0, my1;
-			/* 2B6A         MY0 = DM(I4,M5) */
-        my0 = *i4++;
-			/* 2B6B         MY1 = DM(I5,M5) */
-        my1 = *i5++;
-			/* 2B6C         MX0 = DM(I1,M1) */
-        mx0 = *i1++;
-			/* 2B69         CNTR = DM($15EF) (063f) */
-			/* 2B6D         DO $2B76 UNTIL CE */
-        for (kk = 0; kk < mem63f; kk++) {
-          INT16 ax0, ay0, ay1, ar;
-          INT32 tmp, mr;
-			/* 2B6E           MR = MX0 * MY0 (SS), MX1 = DM(I1,M1) */
-          mx1 = *i1++;
-          tmp = (((INT32)mx0 * my0)<<1);
-          mr = tmp;
-			/* 2B6F           MR = MR - MX1 * MY1 (RND), AY0 = DM(I0,M1) */
-          ay0 = *i0++;
-          tmp = (((INT32)mx1 * my1)<<1);
-          mr = (mr - tmp + 0x8000) & (((tmp & 0xffff) == 0x8000) ? 0xfffeffff : 0xffffffff);
-			/* 2B70           MR = MX1 * MY0 (SS), AX0 = MR1 */
-          ax0 = mr>>16;
-          tmp = (mx1 * my0)<<1;
-          mr = tmp;
-			/* 2B71           MR = MR + MX0 * MY1 (RND), AY1 = DM(I0,M0) */
-          ay1 = *i0--; /* M0 = -1 */
-          tmp = (((INT32)mx0 * my1)<<1);
-          mr = (mr + tmp + 0x8000) & (((tmp & 0xffff) == 0x8000) ? 0xfffeffff : 0xffffffff);
-			/* 2B72           AR = AY0 - AX0, MX0 = DM(I1,M1) */
-          mx0 = *i1++;
-          ar = ay0 - ax0;
-			/* 2B73           AR = AX0 + AY0, DM(I0,M1) = AR */
-          *i0++ = ar;
-          ar = ax0 + ay0;
-			/* 2B74           AR = AY1 - MR1, DM(I2,M1) = AR */
-          *i2++ = ar;
-          ar = ay1 - (mr>>16);
-			/* 2B75           AR = MR1 + AY1, DM(I0,M1) = AR */
-          *i0++ = ar;
-          ar = (mr>>16) + ay1;
-			/* 2B76           DM(I2,M1) = AR */
-          *i2++ = ar;
-        }
-			/* 2B77         MODIFY (I2,M2) */
-        i2 += m2;
-			/* 2B78         MODIFY (I1,M3) */
-        i1 += m3;
-			/* 2B79         MODIFY (I0,M2) */
-        i0 += m2;
-      }
-			/* 2B7A       SI = DM($15EB) (063d) */
-			/* 2B7B:      SR = LSHIFT SI BY 1 (LO) */
-			/* 2B7C:      DM($15EB) = SR0 (063d) */
-      mem63d <<= 1;
-			/* 2B7D       SI = DM($15EF) (063f) */
-			/* 2B7E       DM($15ED) = SI (063e) */
-      mem63e = mem63f;
-			/* 2B7F       SR = LSHIFT SI BY -1 (LO) */
-			/* 2B80       DM($15EF) = SR0 (063f) */
-      mem63f >>= 1;
+    /* each word of the first half only meets the same word of the second half */
+    for (ii = 0; ii < 0x0080; ii++) {
+      const INT16 ax = x[ii], ay = x[0x0080 + ii];
+      x[ii]          = ax + ay;
+      x[0x0080 + ii] = ax - ay;
     }
   }
+			/* 2B54 - 2B80: 6 butterfly passes, see dcs_butterflies() */
+  dcs_butterflies((INT16 *)ram2source, tw, 0x40, 2, 0x40, 6);
   { /* Volume scaling */
-    UINT16 *i0;
-    UINT16 my0;
+    INT16 * const x = (INT16 *)ram2source;
+    INT32 my0;
 			/* 2B81     M0 = $0000 */
 			/* 2B82     I0 = $2000 >>> (3800) <<< */
-    i0 = &ram2source[0x0000];
 			/* 2B84     MY0 = DM($15FD) (390e) */
     my0 = MIN(volume,0x8000); // be paranoid about the volume, see code below
 			/* 2B83     CNTR = $0100 */
 			/* 2B85     DO $2B89 UNTIL CE */
-    /* M0 = 0, M1 = 1 */
-    for (ii = 0; ii < 0x0100; ii++) {
-      INT16 mx0;
-      INT32 mr;
 			/* 2B86       MX0 = DM(I0,M0) */
-      mx0 = *i0;
 			/* 2B87       MR = MX0 * MY0 (SU) */
-      mr = ((INT32)mx0 * my0); // <<1; // see shift below
 			/* 2B88       IF MV SAT MR */
       /* This instruction limits MR to 32 bits */
       /* In reality the volume will never be higher than 0x8000 so */
       /* this is not needed */
 			/* 2B89       DM(I0,M1) = MR1 */
-      *i0++ = mr>>15; // >>16; // see above
-    }
+    for (ii = 0; ii < 0x0100; ii++)
+      x[ii] = ((INT32)x[ii] * my0) >> 15; // <<1 >>16, see above
   }
+  dcs_cachePut(ram2source);
   activecpu_set_reg(ADSP2100_PC, pc + 0x2b89 - 0x2b44);
   return 0; /* execute a NOP */
 }
@@ -2470,8 +2500,30 @@ UINT32 dcs_speedup_1993(UINT32 pc)
     UINT32 volumeOP = *(UINT32 *)&OP_ROM[ADSP2100_PGM_OFFSET + ((pc+0x0135-0x00e8)<<2)];
     UINT16 *ram = (UINT16 *)(dcslocals.cpuRegion + ADSP2100_DATA_OFFSET);
     UINT16 volume = ram[((volumeOP>>4)&0x3fff)];
+    INT16 tw[2*0x80];
     /*DBGLOG(("OP=%6x addr=%4x V=%4x\n",volumeOP,(volumeOP>>4)&0x3fff,volume));*/
 
+    /*
+     *   The twiddle factors of the butterfly passes are tables in program
+     *   ROM (010A I4 = PGM WORD PTR [$1780], 010B I5 = PGM WORD PTR [$1700]).
+     *   These are 32-bit opcode locations addressed as 16-bit memory
+     *   locations; when we read these, we have to shift the results right
+     *   by 8 bits and then truncate to 16 bits to extract the data values.
+     *   That's just the way the ADSP-2100 works when this addressing mode
+     *   is used.
+     */
+    for (ii = 0 ; ii < 0x80 ; ii++)
+    {
+        tw[ii]        = (*(UINT32 *)&OP_ROM[ADSP2100_PGM_OFFSET + ((0x1780 + ii)<<2)]) >> 8;
+        tw[0x80 + ii] = (*(UINT32 *)&OP_ROM[ADSP2100_PGM_OFFSET + ((0x1700 + ii)<<2)]) >> 8;
+    }
+    if (dcs_cacheGet(&ram[0x3800], 0x200, volume, tw, 0x80))
+    {
+        activecpu_set_reg(ADSP2100_MSTAT, 0x0000);
+        activecpu_set_reg(ADSP2100_PC, pc + (0x13a - 0x00e8));
+        return 0;                                          /* execute a NOP */
+    }
+
     {
         UINT16 *i0, *i1, *i2, *i3;
 
@@ -2563,167 +2615,12 @@ UINT32 dcs_speedup_1993(UINT32 pc)
 	// since it affects calculations in the emulated code after we return.
 	activecpu_set_reg(ADSP2100_MSTAT, 0x0000);
 
-    {
-        int mem621, mem622, mem623;
-        int jj,kk;
-
-        /* 
-         *   Note that these three data words ($621, $622, $623) are used in
-         *   the ROM code as scratch locations that are only accessed within
-         *   this loop, so it's not necessary to save them back to real
-         *   memory.  And we don't care about any pre-existing values, as the
-         *   first thing we do here is initialize them.  We refer to them
-         *   here as "memXXX" locations only for ease of reference back to
-         *   the original ROM code.
-         */
-        
-        /* 0101     AR = $0002 */
-        /* 0102     WORD PTR [$621] = AR */
-        mem621 = 2;
-
-        /* 0103     SI = $0080 */
-        /* 0104     WORD PTR [$622] = SI */
-        mem622 = 0x80;
-
-        /* 0105     SR = SI >> 1 */
-        /* 0106     WORD PTR [$623] = SR */
-        mem623 = 0x40;
-
-        /* 0107     M0 = -1 */
-        /* 0108     CNTR = 7 */
-        /* 0109     DO $12D UNTIL CE (loop 7 times) */
-        for (ii = 0 ; ii < 7 ; ++ii)
-        {
-            UINT16 *i0, *i1, *i2;
-            UINT32 *i4, *i5;
-            INT16 m2, m3;
-
-            /* 
-             *   NB: I4 and I5 are used to access PROGRAM ROM, not data
-             *   memory.  These appear to be fixed tables stored in program
-             *   ROM.  Note that these are 32-bit opcode locations addressed
-             *   as 16-bit memory locations; when we read these, we have to
-             *   shift the results right by 8 bits and then truncate to 16
-             *   bits to extract the data values.  Don't ask me what the
-             *   logic is behind this; that's just the way the ADSP-2100
-             *   works when this addressing mode is used.  We could be tricky
-             *   here and bump the byte addresses up by one to skip the
-             *   right-shift step, but that would cause non-dword aligned
-             *   memory reads, which is probably slower than executing the
-             *   extra right-shift instruction (as it requires two bus cycles
-             *   to physical memory).
-             */
-            
-            /* 010A   I4 = PGM WORD PTR [$1780] */
-            i4 = (UINT32 *)&OP_ROM[ADSP2100_PGM_OFFSET + (0x1780<<2)];
-
-            /* 010B   I5 = PGM WORD PTR [$1700] */
-            i5 = (UINT32 *)&OP_ROM[ADSP2100_PGM_OFFSET + (0x1700<<2)];
-
-            /* 010C   I0 = $3800 */
-            i0 = &ram[0x3800];
-
-            /* 010D   I1 = $3800 */
-            i1 = &ram[0x3800];
-            
-            /* 010E   AY0 = WORD PTR [$622] */
-            /* 010F   M2 = AY0 */
-            m2 = mem622;
-
-            /* 0110   MODIFY(I1,M2) */
-            i1 += m2;
-
-            /* 0111   I2 = I1 */
-            i2 = i1;
-
-            /* 0112   AR = AY0 - 1 */
-            /* 0113   M3 = AR */
-            m3 = mem622 - 1;
-
-            /* 0114   CNTR = WORD PTR [$621] */
-            /* 0115   DO $126 UNTIL CE (loop WORD PTR [$621] times) */
-            for (jj = 0 ; jj < mem621 ; ++jj)
-            {
-                INT16 mx0, mx1, my0, my1;
-
-                /* 0117   MY0 = DM(I4,M5) (program ROM location -> shift right by 8 for data) */
-                my0 = (*i4++) >> 8;
-
-                /* 0118   MY1 = DM(I5,M5) (program ROM location -> shift right by 8 for data) */
-                my1 = (*i5++) >> 8;
-
-                /* 0119   MX0 = DM(I1,M1) */
-                mx0 = *i1++;
-
-                /* 0116   CNTR = WORD PTR [$623] */
-                /* 011A   DO $123 UNTIL CE (loop WORD PTR [$623] times) */
-                for (kk = 0 ; kk < mem623 ; ++kk)
-                {
-                    INT16 ax0, ay0, ay1, ar;
-                    INT32 tmp, mr;
-                    
-                    /* 011B   MR = (MX0 * MY0) << 1, MX1 = DM(I1,M1) */
-                    mx1 = *i1++;
-                    mr = ((INT32)mx0 * my0) << 1;
-
-                    /* 011C   MR -= (MX1 * MY1) << 1 (RND), AY0 = DM(I0,M1) */
-                    ay0 = *i0++;
-                    tmp = ((INT32)mx1 * my1) << 1;
-                    mr = (mr - tmp + 0x8000) & (((tmp & 0xffff) == 0x8000) ? 0xfffeffff : 0xffffffff);
-
-                    /* 011D   MR = (MX1 * MY0) << 1 (SS), AX0 = MR1 */
-                    ax0 = mr >> 16;
-                    mr = ((INT32)mx1 * my0) << 1;
-                    
-                    /* 011E   MR += (MX0 * MY1) << 1 (RND), AY1 = DM(I0,M0) */
-                    ay1 = *i0--;
-                    tmp = (((INT32)mx0 * my1)<<1);
-                    mr = (mr + tmp + 0x8000) & (((tmp & 0xffff) == 0x8000) ? 0xfffeffff : 0xffffffff);
-
-                    /* 011F   MX0 = DM(I1,M1), AR = AY0 - AX0 */
-                    mx0 = *i1++;
-                    ar = ay0 - ax0;
-
-                    /* 0120   AR = AX0 + AY0, DM(I0,M1) = AR */
-                    *i0++ = ar;
-                    ar = ax0 + ay0;
-                    
-                    /* 0121   AR = AY1 - MR1, DM(I2,M1) = AR */
-                    *i2++ = ar;
-                    ar = ay1 - (mr >> 16);
-
-                    /* 0122   AR = MR1 + AY1, DM(I0,M1) = AR */
-                    *i0++ = ar;
-                    ar = (mr >> 16) + ay1;
-                    
-                    /* 0123   DM(I2,M1) = AR */
-                    *i2++ = ar;
-                }
-
-                /* 0124   MODIFY (I2,M2) */
-                i2 += m2;
-
-                /* 0125   MODIFY (I1,M3) */
-                i1 += m3;
-                
-                /* 0126   MODIFY (I0,M2) */
-                i0 += m2;
-            }
-
-            /* 0127   SI = WORD PTR [$621] */
-            /* 0128   SR = SI << 1 */
-            /* 0129   WORD PTR [$621] = SR */
-            mem621 <<= 1;
-
-            /* 012A   SI = WORD PTR [$623] */
-            /* 012B   WORD PTR [$622] = SI */
-            mem622 = mem623;
-
-            /* 012C   SR = SI >> 1 */
-            /* 012D   WORD PTR [$623] = SR0 */
-            mem623 >>= 1;
-        }
-	}
+    /* 
+     *   0101 - 012D: the butterfly passes, see dcs_butterflies().  Almost
+     *   identical to the 1994+ version, but with an extra pass: the ROM code
+     *   starts with 2 groups ($621) of $80 words ($622) and loops 7 times.
+     */
+    dcs_butterflies((INT16 *)&ram[0x3800], tw, 0x80, 2, 0x80, 7);
 
 	/* 
 	 *   This appears to be a Fast Fourier Transform pass over the decoded
@@ -2774,6 +2671,7 @@ UINT32 dcs_speedup_1993(UINT32 pc)
             i4 += 2;
         }
 	}
+    dcs_cachePut(&ram[0x3800]);
     activecpu_set_reg(ADSP2100_PC, pc + (0x13a - 0x00e8));
     return 0;                                              /* execute a NOP */
 }
@@ -10,6 +10,7 @@
 #include "sim.h"
 #include "core.h"
 #include "wpc.h"
+#include "dmdrec.h"
 #ifdef PROC_SUPPORT
 #include "p-roc/p-roc.h"
 #endif
@@ -387,6 +388,7 @@ static INTERRUPT_GEN(wpc_vblank) {
     if ((wpclocals.vblankCount % (WPC_VBLANKDIV/2)) == 0) {
       /*-- This is the real VBLANK interrupt --*/
       dmdlocals.DMDFrames[dmdlocals.nextDMDFrame] = memory_region(WPC_DMDREGION) + (wpc_data[DMD_VISIBLEPAGE] & 0x0f) * 0x200;
+      dmdrec_subFrame(0, 128, 32, 1, 1, DMDREC_WEIGHTS(1,0,0,0), dmdlocals.DMDFrames[dmdlocals.nextDMDFrame], 0x200, 0);
 #ifdef PROC_SUPPORT
 			if (coreGlobals.p_rocEn) {
 				/* looks like P-ROC uses the last 3 subframes sent rather than the first 3 */
@@ -968,10 +970,45 @@ static void wpc_pic_w(int data) {
   wpclocals.pic.lastW = data;
 }
 
+/*----------------------------------------------------
+/  Sample the outputs for the sub-frame integrator.
+/  Called before the IRQ handler strobes the next lamp
+/  column, so this is the state driven since the last IRQ
+/-----------------------------------------------------*/
+static void wpc_pwm_sample(void) {
+  UINT8 lamps[8], sols[8];
+  float gi[CORE_MAXGI];
+  UINT64 solBits;
+  int ii;
+
+  for (ii = 0; ii < 8; ii++)
+    lamps[ii] = (wpc_data[WPC_LAMPCOLUMN] & (1<<ii)) ? wpc_data[WPC_LAMPROW] : 0;
+  core_pwm_sampleBits(CORE_PWM_LAMPS, lamps);
+
+  /*-- same numbering as core_getSol() --*/
+  solBits = coreGlobals.pulsedSolState & 0x0fffffff;
+  if (core_gameData->gen & (GEN_WPC95 | GEN_WPC95DCS))
+    solBits |= (UINT64)(coreGlobals.pulsedSolState & 0xf0000000) << 8;
+  solBits |= (UINT64)((coreGlobals.solenoids2 >> 8) & 0x0f) << 28;
+  solBits |= (UINT64)((wpclocals.solFlip >> 4) & 0x0f) << 32;
+  solBits |= (UINT64)(wpclocals.solFlip & 0x0f) << 44;
+  if (wpc_modsol_aux_board > 0)
+    solBits |= (UINT64)((wpc_modsol_aux_board == 1) ? wpc_data[WPC_EXTBOARD1] : wpc_data[WPC_EXTBOARD2]) << (CORE_FIRSTCUSTSOL-1);
+  for (ii = 0; ii < 8; ii++)
+    sols[ii] = (UINT8)(solBits >> (ii*8));
+  core_pwm_sampleBits(CORE_PWM_SOLS, sols);
+
+  /*-- the triacs are fired once per mains half wave, use the level derived from the firing time --*/
+  for (ii = 0; ii < CORE_MAXGI; ii++)
+    gi[ii] = coreGlobals.gi[ii] / 8.0f;
+  core_pwm_sampleLevels(CORE_PWM_GI, gi);
+}
+
 /*-------------------------
 /  Generate IRQ interrupt
 /--------------------------*/
 static INTERRUPT_GEN(wpc_irq) {
+  wpc_pwm_sample();
 #ifdef WPC_MODSOLSAMPLE
 	if (options.usemodsol)
 	{
@@ -1153,6 +1190,14 @@ static MACHINE_INIT(wpc) {
   if ((core_gameData->hw.flippers & FLIP_SOL(FLIP_UL)) == 0) /* No upper left flipper */
     wpclocals.nonFlipBits |= CORE_ULFLIPSOLBITS;
 
+  /*-- the main RAM is only written by the main CPU, so its idle loops can be skipped --*/
+  m6809_set_idle_skip(WPC_CPUNO, pmoptions.idle_skip);
+
+  /*-- sub-frame outputs, the lamp matrix is strobed one column per IRQ --*/
+  core_pwm_init(CORE_PWM_LAMPS, 64, CORE_PWM_BULB, 8.0f);
+  core_pwm_init(CORE_PWM_SOLS, 64, CORE_PWM_FLASHER, 1.0f);
+  core_pwm_init(CORE_PWM_GI, CORE_MAXGI, CORE_PWM_BULB, 1.0f);
+
   if (options.cheat && !(core_gameData->gen & GEN_WPCALPHA_1)) {
     /*-- speed up startup by disable checksum and also make tom_14h(c) work --*/
     *(memory_region(WPC_CPUREGION) + 0xffec) = 0x00;